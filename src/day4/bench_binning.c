@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "binning.h"
+#include "perf_clock.h"
+
+// Bins a synthetic wafer lot of speed/voltage/power measurements on one core
+// and on all cores, and checks both against a straightforward first-match
+// reference. Usage: bench_binning [devices] [threads]
+
+#define BENCH_DEFAULT_DEVICES 2000000u
+
+enum { P_FMAX_GHZ, P_VMIN_V, P_IDD_MA, P_LEAKAGE_UA, P_RING_OSC_MHZ, P_TEMP_OFFSET_C, P_COUNT };
+
+static uint32_t bench_rng = 2024;
+
+static float bench_gauss(float mean, float sigma) {
+    // Sum of four uniforms: cheap and close enough to normal for test data
+    float sum = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        bench_rng = bench_rng * 1664525u + 1013904223u;
+        sum += (float)(bench_rng >> 8) / 16777216.0f;
+    }
+    return mean + sigma * (sum - 2.0f) * 1.732f;
+}
+
+static int build_rules(binning_table_t* table) {
+    const float none = INFINITY;
+    const float guard[P_COUNT] = { 0.02f, 0.01f, 10.0f, 2.0f, 5.0f, 0.5f };
+    
+    const float bin1_lo[P_COUNT] = { 1.20f, -none, -none, -none, 980.0f, -3.0f };
+    const float bin1_hi[P_COUNT] = { none, 0.85f, 900.0f, 50.0f, none, 3.0f };
+    const float bin2_lo[P_COUNT] = { 1.00f, -none, -none, -none, 900.0f, -5.0f };
+    const float bin2_hi[P_COUNT] = { none, 0.90f, 1000.0f, 80.0f, none, 5.0f };
+    const float leak_lo[P_COUNT] = { -none, -none, -none, 80.0f, -none, -none };
+    const float leak_hi[P_COUNT] = { none, none, none, none, none, none };
+    
+    return binning_table_init(table, P_COUNT, "Parametric fail", 9, 99) ||
+           binning_add_rule(table, "Bin 1 fast", 1, 1, bin1_lo, bin1_hi, guard) ||
+           binning_add_rule(table, "Bin 1 marginal", 1, 2, bin1_lo, bin1_hi, NULL) ||
+           binning_add_rule(table, "Bin 2 standard", 2, 3, bin2_lo, bin2_hi, guard) ||
+           binning_add_rule(table, "Bin 2 marginal", 2, 4, bin2_lo, bin2_hi, NULL) ||
+           binning_add_rule(table, "Leakage fail", 5, 10, leak_lo, leak_hi, NULL);
+}
+
+// First match with early exits: the obvious implementation
+static uint32_t reference_classify(const binning_table_t* table, const float* m) {
+    for (uint32_t rule = 0; rule < table->rule_count; rule++) {
+        uint32_t p;
+        for (p = 0; p < table->param_count; p++) {
+            float lo = table->lo[rule * table->param_count + p];
+            float hi = table->hi[rule * table->param_count + p];
+            if (!(m[p] >= lo && m[p] <= hi)) {
+                break;
+            }
+        }
+        if (p == table->param_count) {
+            return rule;
+        }
+    }
+    return table->rule_count;
+}
+
+int main(int argc, char* argv[]) {
+    size_t devices = (argc > 1) ? (size_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_DEVICES;
+    uint32_t threads = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 0;  // 0 = all cores
+    static binning_table_t table;
+    
+    if (devices == 0 || build_rules(&table) != 0) {
+        fprintf(stderr, "usage: %s [devices] [threads]\n", argv[0]);
+        return 1;
+    }
+    
+    float* data = malloc(devices * P_COUNT * sizeof(float));
+    uint16_t* soft_serial = malloc(devices * sizeof(uint16_t));
+    uint16_t* soft_parallel = malloc(devices * sizeof(uint16_t));
+    uint16_t* hard_parallel = malloc(devices * sizeof(uint16_t));
+    if (!data || !soft_serial || !soft_parallel || !hard_parallel) {
+        fprintf(stderr, "Out of memory for %zu devices\n", devices);
+        return 1;
+    }
+    
+    for (size_t i = 0; i < devices; i++) {
+        float* m = &data[i * P_COUNT];
+        m[P_FMAX_GHZ] = bench_gauss(1.20f, 0.08f);
+        m[P_VMIN_V] = bench_gauss(0.84f, 0.03f);
+        m[P_IDD_MA] = bench_gauss(850.0f, 60.0f);
+        m[P_LEAKAGE_UA] = bench_gauss(45.0f, 15.0f);
+        m[P_RING_OSC_MHZ] = bench_gauss(1000.0f, 30.0f);
+        m[P_TEMP_OFFSET_C] = bench_gauss(0.0f, 1.5f);
+    }
+    
+    binning_result_t serial;
+    binning_result_t parallel;
+    perf_clock_calibrate();
+    
+    perf_ticks_t start = perf_clock_now();
+    binning_run(&table, data, devices, 1, NULL, soft_serial, &serial);
+    uint64_t serial_ns = perf_clock_to_ns(perf_clock_now() - start);
+    
+    start = perf_clock_now();
+    binning_run(&table, data, devices, threads, hard_parallel, soft_parallel, &parallel);
+    uint64_t parallel_ns = perf_clock_to_ns(perf_clock_now() - start);
+    
+    printf("Device binning: %zu devices x %d parameters, %u rules\n",
+           devices, P_COUNT, (unsigned)table.rule_count);
+    printf("  1 thread:   %8.1f ms (%.1f M devices/s)\n", serial_ns / 1e6,
+           serial_ns ? devices * 1e3 / serial_ns : 0.0);
+    printf("  %u threads: %8.1f ms (%.1f M devices/s)\n", (unsigned)parallel.threads_used,
+           parallel_ns / 1e6, parallel_ns ? devices * 1e3 / parallel_ns : 0.0);
+    
+    printf("\n%-18s %5s %5s %10s %7s\n", "Bin", "Hard", "Soft", "Devices", "Share");
+    for (uint32_t bin = 0; bin <= table.rule_count; bin++) {
+        printf("%-18s %5u %5u %10llu %6.2f%%\n", table.bins[bin].name,
+               (unsigned)table.bins[bin].hard_bin, (unsigned)table.bins[bin].soft_bin,
+               (unsigned long long)parallel.counts[bin], 100.0 * parallel.counts[bin] / devices);
+    }
+    
+    int failures = 0;
+    for (uint32_t bin = 0; bin <= table.rule_count; bin++) {
+        failures += serial.counts[bin] != parallel.counts[bin];
+    }
+    for (size_t i = 0; i < devices; i++) {
+        uint32_t expected = reference_classify(&table, &data[i * P_COUNT]);
+        failures += soft_serial[i] != table.bins[expected].soft_bin ||
+                    soft_parallel[i] != table.bins[expected].soft_bin ||
+                    hard_parallel[i] != table.bins[expected].hard_bin;
+    }
+    printf("\nReference check: %s (%d mismatches)\n", failures ? "FAIL" : "PASS", failures);
+    
+    free(data);
+    free(soft_serial);
+    free(soft_parallel);
+    free(hard_parallel);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,43 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include "fpga_hal.h"
+
+// Per-call cost of hal_gpio_write() for the HAL variant this binary links.
+// Built twice by CMake: against fpga_hal_log_off (HAL_LOG_LEVEL_NONE) and
+// fpga_hal_log_on (HAL_LOG_LEVEL_DEBUG with the runtime level at DEBUG).
+
+#define BENCH_ITERATIONS 200000
+
+#ifndef BENCH_VARIANT
+#define BENCH_VARIANT "unknown"
+#endif
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+int main(void) {
+    // Log output is real work we want to time, but not to read
+    if (!freopen("/dev/null", "w", stdout)) {
+        fprintf(stderr, "Could not redirect stdout\n");
+        return 1;
+    }
+    
+    hal_log_set_level(HAL_LOG_LEVEL_DEBUG);
+    hal_gpio_init();
+    hal_gpio_set_direction(0, GPIO_OUTPUT);
+    
+    uint64_t start = now_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        hal_gpio_write(0, i & 1);
+    }
+    uint64_t elapsed = now_ns() - start;
+    
+    fprintf(stderr, "hal_gpio_write [%s]: %.1f ns/call (%d calls)\n",
+            BENCH_VARIANT, (double)elapsed / BENCH_ITERATIONS, BENCH_ITERATIONS);
+    return 0;
+}
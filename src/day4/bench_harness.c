@@ -0,0 +1,287 @@
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "bench_harness.h"
+#include "perf_clock.h"
+
+#ifndef __riscv
+#include <fcntl.h>
+#include <unistd.h>
+#define BENCH_CAN_MUTE 1
+#else
+#define BENCH_CAN_MUTE 0
+#endif
+
+#define BENCH_NAME_LEN 64
+
+volatile uint64_t bench_sink;
+
+typedef struct {
+    char name[BENCH_NAME_LEN];
+    double median_ns;
+} bench_baseline_t;
+
+static bench_baseline_t baseline[BENCH_MAX_CASES];
+static uint32_t baseline_count;
+static double samples[BENCH_MAX_SAMPLES];
+static int muted_fd = -1;
+
+// Case output goes to /dev/null while timing; the report still reaches stdout
+static void bench_mute(void) {
+#if BENCH_CAN_MUTE
+    fflush(stdout);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd < 0) return;
+    muted_fd = dup(STDOUT_FILENO);
+    dup2(null_fd, STDOUT_FILENO);
+    close(null_fd);
+#endif
+}
+
+static void bench_unmute(void) {
+#if BENCH_CAN_MUTE
+    if (muted_fd < 0) return;
+    fflush(stdout);
+    dup2(muted_fd, STDOUT_FILENO);
+    close(muted_fd);
+    muted_fd = -1;
+#endif
+}
+
+// Our own --json output has one result per line, so a line scan is enough
+static void bench_load_baseline(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "bench: cannot read baseline %s\n", path);
+        return;
+    }
+    
+    char line[512];
+    while (baseline_count < BENCH_MAX_CASES && fgets(line, sizeof(line), file)) {
+        const char* name = strstr(line, "\"name\": \"");
+        const char* median = strstr(line, "\"median_ns\": ");
+        if (!name || !median) continue;
+        
+        name += strlen("\"name\": \"");
+        const char* end = strchr(name, '"');
+        size_t length = end ? (size_t)(end - name) : 0;
+        if (length == 0 || length >= BENCH_NAME_LEN) continue;
+        
+        bench_baseline_t* entry = &baseline[baseline_count++];
+        memcpy(entry->name, name, length);
+        entry->name[length] = '\0';
+        entry->median_ns = strtod(median + strlen("\"median_ns\": "), NULL);
+    }
+    fclose(file);
+}
+
+static double bench_baseline_for(const char* name) {
+    for (uint32_t i = 0; i < baseline_count; i++) {
+        if (strcmp(baseline[i].name, name) == 0) return baseline[i].median_ns;
+    }
+    return 0.0;
+}
+
+int bench_init(bench_suite_t* suite, const char* title, int argc, char* argv[]) {
+    memset(suite, 0, sizeof(*suite));
+    suite->title = title;
+    suite->target_sample_ns = 100000.0;
+    suite->min_samples = 10;
+    suite->max_samples = 100;
+    suite->stable_tolerance = 0.02;
+    suite->regression_threshold = 0.25;
+    
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strncmp(arg, "--filter=", 9) == 0) {
+            suite->filter = arg + 9;
+        } else if (strncmp(arg, "--json=", 7) == 0) {
+            suite->json_path = arg + 7;
+        } else if (strncmp(arg, "--baseline=", 11) == 0) {
+            suite->baseline_path = arg + 11;
+        } else if (strncmp(arg, "--threshold=", 12) == 0) {
+            suite->regression_threshold = strtod(arg + 12, NULL) / 100.0;
+        } else if (strcmp(arg, "--quick") == 0) {
+            suite->target_sample_ns = 20000.0;
+            suite->min_samples = 5;
+            suite->max_samples = 20;
+            suite->stable_tolerance = 0.05;
+        } else {
+            fprintf(stderr, "usage: %s [--filter=TEXT] [--json=PATH] [--baseline=PATH] "
+                            "[--threshold=PCT] [--quick]\n", argv[0]);
+            return -1;
+        }
+    }
+    
+    baseline_count = 0;
+    if (suite->baseline_path) {
+        bench_load_baseline(suite->baseline_path);
+    }
+    perf_clock_calibrate();
+    return 0;
+}
+
+static double bench_sample(const bench_case_t* bench_case, uint64_t iterations) {
+    if (bench_case->setup) {
+        bench_case->setup(bench_case->context, iterations);
+    }
+    
+    perf_ticks_t start = perf_clock_now();
+    bench_case->fn(bench_case->context, iterations);
+    perf_ticks_t elapsed = perf_clock_now() - start;
+    
+    perf_ticks_t overhead = perf_clock_overhead();
+    return (double)perf_clock_to_ns(elapsed > overhead ? elapsed - overhead : 0);
+}
+
+static int bench_compare_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double bench_median(uint32_t count) {
+    static double sorted[BENCH_MAX_SAMPLES];
+    memcpy(sorted, samples, count * sizeof(double));
+    qsort(sorted, count, sizeof(double), bench_compare_double);
+    return sorted[count / 2];
+}
+
+void bench_run(bench_suite_t* suite, const bench_case_t* bench_case) {
+    if (suite->filter && !strstr(bench_case->name, suite->filter)) return;
+    if (suite->result_count >= BENCH_MAX_CASES) return;
+    
+    uint64_t cap = bench_case->max_iterations ? bench_case->max_iterations : (1ull << 32);
+    uint32_t max_samples = suite->max_samples < BENCH_MAX_SAMPLES ? suite->max_samples
+                                                                   : BENCH_MAX_SAMPLES;
+    bench_mute();
+    
+    // Warm up, then grow the iteration count until a sample is long enough
+    bench_sample(bench_case, 1);
+    uint64_t iterations = 1;
+    for (;;) {
+        double ns = bench_sample(bench_case, iterations);
+        if (ns >= suite->target_sample_ns || iterations >= cap) break;
+        
+        double scale = ns > 0.0 ? suite->target_sample_ns * 1.1 / ns : 10.0;
+        if (scale > 10.0) scale = 10.0;
+        uint64_t next = (uint64_t)(iterations * scale) + 1;
+        iterations = next > cap ? cap : next;
+    }
+    
+    // Sample in batches until the median settles
+    uint32_t count = 0;
+    double previous = 0.0;
+    int stable = 0;
+    while (count + suite->min_samples <= max_samples) {
+        for (uint32_t i = 0; i < suite->min_samples; i++) {
+            samples[count++] = bench_sample(bench_case, iterations) / (double)iterations;
+        }
+        double median = bench_median(count);
+        if (previous > 0.0 && fabs(median - previous) <= suite->stable_tolerance * previous) {
+            stable = 1;
+            break;
+        }
+        previous = median;
+    }
+    
+    bench_unmute();
+    
+    qsort(samples, count, sizeof(double), bench_compare_double);
+    uint32_t p99 = (uint32_t)ceil(0.99 * count);
+    
+    bench_result_t* result = &suite->results[suite->result_count++];
+    result->name = bench_case->name;
+    result->iterations = iterations;
+    result->samples = count;
+    result->stable = stable;
+    result->min_ns = samples[0];
+    result->median_ns = samples[count / 2];
+    result->p99_ns = samples[(p99 > 0 ? p99 : 1) - 1];
+    result->ops_per_s = result->median_ns > 0.0 ? 1e9 / result->median_ns : 0.0;
+    result->baseline_ns = bench_baseline_for(bench_case->name);
+}
+
+void bench_case(bench_suite_t* suite, const char* name, bench_fn_t fn, void* context) {
+    bench_case_t bench_case = {name, fn, NULL, context, 0};
+    bench_run(suite, &bench_case);
+}
+
+static int bench_regressed(const bench_suite_t* suite, const bench_result_t* result) {
+    return result->baseline_ns > 0.0 &&
+           result->median_ns > result->baseline_ns * (1.0 + suite->regression_threshold);
+}
+
+static void bench_json_string(FILE* out, const char* text) {
+    fputc('"', out);
+    for (; *text; text++) {
+        if (*text == '"' || *text == '\\') fputc('\\', out);
+        fputc(*text, out);
+    }
+    fputc('"', out);
+}
+
+static void bench_write_json(const bench_suite_t* suite, FILE* out) {
+    fprintf(out, "{\n  \"suite\": ");
+    bench_json_string(out, suite->title);
+    fprintf(out, ",\n  \"clock\": ");
+    bench_json_string(out, perf_clock_source());
+    fprintf(out, ",\n  \"results\": [\n");
+    
+    for (uint32_t i = 0; i < suite->result_count; i++) {
+        const bench_result_t* r = &suite->results[i];
+        fprintf(out, "    {\"name\": ");
+        bench_json_string(out, r->name);
+        fprintf(out, ", \"iterations\": %llu, \"samples\": %u, \"stable\": %s, "
+                     "\"min_ns\": %.3f, \"median_ns\": %.3f, \"p99_ns\": %.3f, "
+                     "\"ops_per_s\": %.1f}%s\n",
+                (unsigned long long)r->iterations, (unsigned)r->samples,
+                r->stable ? "true" : "false", r->min_ns, r->median_ns, r->p99_ns,
+                r->ops_per_s, i + 1 < suite->result_count ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+int bench_finish(bench_suite_t* suite) {
+    FILE* json_out = NULL;
+    if (suite->json_path && strcmp(suite->json_path, "-") != 0) {
+        json_out = fopen(suite->json_path, "w");
+        if (!json_out) {
+            fprintf(stderr, "bench: cannot write %s\n", suite->json_path);
+            return -1;
+        }
+    }
+    
+    // With JSON on stdout the table goes to stderr
+    FILE* table = (suite->json_path && !json_out) ? stderr : stdout;
+    fprintf(table, "%s (clock: %s)\n", suite->title, perf_clock_source());
+    fprintf(table, "%-40s %10s %10s %10s %14s %s\n",
+            "Case", "min ns", "median ns", "p99 ns", "ops/s", "");
+    
+    suite->regressions = 0;
+    for (uint32_t i = 0; i < suite->result_count; i++) {
+        const bench_result_t* r = &suite->results[i];
+        char note[48] = "";
+        if (bench_regressed(suite, r)) {
+            snprintf(note, sizeof(note), "REGRESSED +%.0f%%",
+                     100.0 * (r->median_ns / r->baseline_ns - 1.0));
+            suite->regressions++;
+        } else if (!r->stable) {
+            snprintf(note, sizeof(note), "(unstable)");
+        }
+        fprintf(table, "%-40s %10.1f %10.1f %10.1f %14.0f %s\n",
+                r->name, r->min_ns, r->median_ns, r->p99_ns, r->ops_per_s, note);
+    }
+    if (suite->baseline_path) {
+        fprintf(table, "%u regression(s) above %.0f%% against %s\n", (unsigned)suite->regressions,
+                100.0 * suite->regression_threshold, suite->baseline_path);
+    }
+    
+    if (suite->json_path) {
+        bench_write_json(suite, json_out ? json_out : stdout);
+        if (json_out && fclose(json_out) != 0) return -1;
+    }
+    return (int)suite->regressions;
+}
@@ -0,0 +1,77 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Small microbenchmark harness. Each case is a function that performs its
+// operation `iterations` times. The harness picks an iteration count that
+// makes one timed sample last about target_sample_ns, then keeps taking
+// samples in batches until the median moves by less than stable_tolerance
+// between batches (or max_samples is reached). Results are per operation:
+// min/median/p99 ns and ops/s at the median.
+//
+// Command line (bench_init):
+//   --filter=TEXT      only cases whose name contains TEXT
+//   --json=PATH        write results as JSON ("-" for stdout)
+//   --baseline=PATH    compare medians with an earlier --json file
+//   --threshold=PCT    regression threshold for --baseline (default 25)
+//   --quick            shorter samples and fewer of them (smoke runs)
+//
+// Case output to stdout is muted while timing (host only), so cases may
+// call functions that print.
+
+#define BENCH_MAX_CASES   160
+#define BENCH_MAX_SAMPLES 200
+
+typedef void (*bench_fn_t)(void* context, uint64_t iterations);
+
+typedef struct {
+    const char* name;
+    bench_fn_t fn;
+    bench_fn_t setup;           // Untimed, before each sample; may be NULL
+    void* context;
+    uint64_t max_iterations;    // Per sample, 0 = no limit (bounded buffers etc.)
+} bench_case_t;
+
+typedef struct {
+    const char* name;
+    uint64_t iterations;        // Per sample
+    uint32_t samples;
+    int stable;
+    double min_ns;              // Per operation
+    double median_ns;
+    double p99_ns;
+    double ops_per_s;
+    double baseline_ns;         // 0 when no baseline entry
+} bench_result_t;
+
+typedef struct {
+    double target_sample_ns;
+    uint32_t min_samples;
+    uint32_t max_samples;
+    double stable_tolerance;
+    double regression_threshold;
+    const char* filter;
+    const char* json_path;
+    const char* baseline_path;
+    const char* title;
+    bench_result_t results[BENCH_MAX_CASES];
+    uint32_t result_count;
+    uint32_t regressions;
+} bench_suite_t;
+
+// Returns -1 on an unknown option
+int bench_init(bench_suite_t* suite, const char* title, int argc, char* argv[]);
+void bench_run(bench_suite_t* suite, const bench_case_t* bench_case);
+void bench_case(bench_suite_t* suite, const char* name, bench_fn_t fn, void* context);
+
+// Prints the table, writes JSON, checks the baseline. Returns the number of
+// regressions (0 without --baseline), or -1 if an output file failed.
+int bench_finish(bench_suite_t* suite);
+
+// Keep results alive so the compiler can't drop the work being timed
+extern volatile uint64_t bench_sink;
+#define bench_consume(value) (bench_sink += (uint64_t)(value))
+
+#endif // BENCH_HARNESS_H
@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "power_analyzer.h"
+#include "perf_clock.h"
+
+// Streams a synthetic 1 MSPS V/I capture through the power analyzer in
+// ADC-sized blocks and checks the summary and every reported violation
+// against a straightforward per-sample reference. The capture idles at
+// 0.2 W with a 1.5 W load step, a 3 W spike and a brownout dip.
+// Usage: bench_power_analyzer [samples]
+
+#define BENCH_DEFAULT_SAMPLES 4000000u
+#define BENCH_RATE_HZ         1000000.0
+#define BENCH_WINDOW          1000u
+#define BENCH_BLOCK           1000u   // Not a multiple of the internal chunk
+#define BENCH_MAX_EVENTS      16
+
+#define PEAK_LIMIT_W   2.5f
+#define WINDOW_HIGH_W  1.2f
+#define WINDOW_LOW_W   0.15f
+
+typedef struct {
+    power_violation_t events[BENCH_MAX_EVENTS];
+    uint32_t count;
+} event_log_t;
+
+static uint32_t bench_rng = 7;
+
+static float bench_noise(float amplitude) {
+    bench_rng = bench_rng * 1664525u + 1013904223u;
+    return amplitude * ((float)(bench_rng >> 8) / 8388608.0f - 1.0f);
+}
+
+static void log_event(const power_violation_t* violation, void* context) {
+    event_log_t* log = context;
+    if (log->count < BENCH_MAX_EVENTS) {
+        log->events[log->count] = *violation;
+    }
+    log->count++;
+}
+
+static float load_current(size_t n, size_t total) {
+    double t = (double)n / total;
+    if (t >= 0.25 && t < 0.50) return 1.5f;                       // Load step
+    if (n >= total * 3 / 4 && n < total * 3 / 4 + 20) return 3.0f;  // 20 us spike
+    if (t >= 0.875 && t < 0.875 + 5000.0 / total) return 0.05f;    // 5 ms dip
+    return 0.2f;
+}
+
+// Per-sample reference: same edge-triggered reporting, no chunking or SIMD
+static void reference_run(const float* v, const float* i, size_t n, event_log_t* log,
+                          double* energy, float* peak, size_t* peak_at) {
+    static double ring[BENCH_WINDOW];
+    double window_sum = 0.0;
+    int open[POWER_VIOLATION_TYPES] = {0};
+    power_violation_t event[POWER_VIOLATION_TYPES] = {{0}};
+    
+    *energy = 0.0;
+    *peak = -INFINITY;
+    for (size_t s = 0; s < n; s++) {
+        float p = v[s] * i[s];
+        *energy += p / BENCH_RATE_HZ;
+        if (p > *peak) {
+            *peak = p;
+            *peak_at = s;
+        }
+        
+        if (s >= BENCH_WINDOW) window_sum -= ring[s % BENCH_WINDOW];
+        ring[s % BENCH_WINDOW] = p;
+        window_sum += p;
+        double average = window_sum / BENCH_WINDOW;
+        int full = s + 1 >= BENCH_WINDOW;
+        
+        int violated[POWER_VIOLATION_TYPES] = {
+            p > PEAK_LIMIT_W, full && average > WINDOW_HIGH_W, full && average < WINDOW_LOW_W
+        };
+        for (int type = 0; type < POWER_VIOLATION_TYPES; type++) {
+            if (violated[type] && !open[type]) {
+                open[type] = 1;
+                event[type].type = (power_violation_type_t)type;
+                event[type].start_sample = s;
+            } else if (!violated[type] && open[type]) {
+                open[type] = 0;
+                event[type].end_sample = s;
+                log_event(&event[type], log);
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t samples = (argc > 1) ? (size_t)strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_SAMPLES;
+    if (samples < 100000) {
+        fprintf(stderr, "usage: %s [samples >= 100000]\n", argv[0]);
+        return 1;
+    }
+    
+    float* voltage = malloc(samples * sizeof(float));
+    float* current = malloc(samples * sizeof(float));
+    if (!voltage || !current) {
+        fprintf(stderr, "Out of memory for %zu samples\n", samples);
+        return 1;
+    }
+    for (size_t n = 0; n < samples; n++) {
+        voltage[n] = 1.0f + bench_noise(0.005f);
+        current[n] = load_current(n, samples) + bench_noise(0.002f);
+    }
+    
+    static float window[BENCH_WINDOW];
+    event_log_t events = {0};
+    power_analyzer_config_t config = {
+        BENCH_RATE_HZ, BENCH_WINDOW, window, PEAK_LIMIT_W, WINDOW_HIGH_W, WINDOW_LOW_W,
+        0.0f, 0.0f, log_event, &events
+    };
+    power_analyzer_t analyzer;
+    power_analyzer_init(&analyzer, &config);
+    perf_clock_calibrate();
+    
+    perf_ticks_t start = perf_clock_now();
+    for (size_t offset = 0; offset < samples; offset += BENCH_BLOCK) {
+        size_t count = (samples - offset < BENCH_BLOCK) ? samples - offset : BENCH_BLOCK;
+        power_analyzer_process(&analyzer, voltage + offset, current + offset, count);
+    }
+    power_analyzer_finish(&analyzer);
+    uint64_t elapsed_ns = perf_clock_to_ns(perf_clock_now() - start);
+    
+    power_summary_t summary;
+    power_analyzer_summary(&analyzer, &summary);
+    printf("Power analyzer (%s): %zu samples in %.1f ms (%.0f M samples/s)\n",
+           power_analyzer_isa(), samples, elapsed_ns / 1e6,
+           elapsed_ns ? samples * 1e3 / elapsed_ns : 0.0);
+    printf("  Energy %.6f J, average %.4f W, peak %.3f W at %.6f s\n",
+           summary.energy_j, summary.average_w, summary.peak_w, summary.peak_ns / 1e9);
+    printf("  RMS %.4f V, %.4f A; window average %.4f..%.4f W\n",
+           summary.rms_voltage, summary.rms_current, summary.window_min_w, summary.window_max_w);
+    for (uint32_t e = 0; e < events.count && e < BENCH_MAX_EVENTS; e++) {
+        const power_violation_t* v = &events.events[e];
+        printf("  Violation %-11s %.6f s .. %.6f s, worst %.3f W\n",
+               power_analyzer_violation_name(v->type), v->start_ns / 1e9, v->end_ns / 1e9,
+               v->worst_w);
+    }
+    
+    event_log_t expected = {0};
+    double energy;
+    float peak;
+    size_t peak_at = 0;
+    reference_run(voltage, current, samples, &expected, &energy, &peak, &peak_at);
+    
+    int failures = 0;
+    failures += fabs(summary.energy_j - energy) > 1e-5 * energy;
+    failures += summary.peak_w != peak || analyzer.peak_sample != peak_at;
+    failures += events.count != expected.count || events.count != 3;
+    for (uint32_t e = 0; e < expected.count && e < events.count && e < BENCH_MAX_EVENTS; e++) {
+        failures += events.events[e].type != expected.events[e].type ||
+                    events.events[e].start_sample != expected.events[e].start_sample ||
+                    events.events[e].end_sample != expected.events[e].end_sample;
+    }
+    printf("\nReference check: %s (%d mismatches)\n", failures ? "FAIL" : "PASS", failures);
+    
+    free(voltage);
+    free(current);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,358 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "bench_harness.h"
+#include "validation_lib.h"
+#include "fpga_hal.h"
+#include "hal_backend.h"
+#include "hal_sim.h"
+
+// Per-call cost of every public function in validation_lib.h and fpga_hal.h,
+// run against the simulated board. HAL figures are host CPU time per call,
+// including the simulator's work; virtual time spent in delays is free.
+// validate_limits() takes the hit path when VALIDATION_LIMITS_FILE points
+// at a compiled table (the bench target sets it), the miss path otherwise.
+//
+//   bench_suite [--quick] [--filter=TEXT] [--json=PATH] [--baseline=PATH]
+
+#define BENCH_BATCH 1024
+
+// One operation per iteration; `n` is the iteration index
+#define BENCH_CASE(name, ...)                                   \
+    static void name(void* context, uint64_t iterations) {     \
+        (void)context;                                          \
+        for (uint64_t n = 0; n < iterations; n++) {             \
+            __VA_ARGS__;                                        \
+        }                                                       \
+    }
+
+static float batch_voltage[BENCH_BATCH];
+static float batch_current[BENCH_BATCH];
+static uint32_t batch_frequency[BENCH_BATCH];
+static uint8_t batch_bitmap[BENCH_BATCH / 8];
+
+static validation_ctx_t bench_ctx;
+static validation_ctx_t sink_ctx;
+static validation_ctx_t merge_src;
+static validation_ctx_t scratch_ctx;
+static validation_sink_t null_sink;
+
+static uint16_t scan_buffer[4];
+static uint16_t stream_storage[3 * 64 * 2];
+static const char uart_bytes[] = "0123456789ABCDEF";
+
+// Validation: scalar checks
+BENCH_CASE(b_validate_voltage, bench_consume(validate_voltage(1.0f + (n & 7) * 0.01f, 1.05f, 0.05f)))
+BENCH_CASE(b_validate_frequency, bench_consume(validate_frequency(99990000u + (uint32_t)(n & 0xFFFF),
+                                                                  100000000u, 50000u)))
+BENCH_CASE(b_validate_power, bench_consume(validate_power(3.3f, 0.5f + (n & 7) * 0.1f, 2.0f)))
+BENCH_CASE(b_validate_frequency_ppm, bench_consume(validate_frequency_ppm(5200000000ull + n,
+                                                                          5200000000ull, 20)))
+BENCH_CASE(b_frequency_error_ppm, bench_consume(frequency_error_ppm(5200000000ull + n, 5200000000ull)))
+BENCH_CASE(b_validate_limits, bench_consume(validate_limits("io_voltage", 1.80 + (n & 3) * 0.01)))
+
+// Validation: batches
+BENCH_CASE(b_validate_voltage_batch,
+           bench_consume(validate_voltage_batch(batch_voltage, BENCH_BATCH, 1.8f, 0.05f, batch_bitmap)))
+BENCH_CASE(b_validate_frequency_batch,
+           bench_consume(validate_frequency_batch(batch_frequency, BENCH_BATCH, 100000000u, 500000u,
+                                                  batch_bitmap)))
+BENCH_CASE(b_validate_power_batch,
+           bench_consume(validate_power_batch(batch_voltage, batch_current, BENCH_BATCH, 2.0f,
+                                              batch_bitmap)))
+BENCH_CASE(b_validation_batch_isa, bench_consume(validation_batch_isa()[0]))
+
+// Validation: contexts
+BENCH_CASE(b_validation_ctx_init, validation_ctx_init(&scratch_ctx, "bench"))
+BENCH_CASE(b_validation_default_ctx, bench_consume((uintptr_t)validation_default_ctx()))
+BENCH_CASE(b_validation_ctx_total, bench_consume(validation_ctx_total(&bench_ctx)))
+BENCH_CASE(b_validation_ctx_passed, bench_consume(validation_ctx_passed(&bench_ctx)))
+BENCH_CASE(b_log_test_result_ctx, log_test_result_ctx(&bench_ctx, "Core Voltage", (n & 15) != 0,
+                                                      3.3f, 3.3f))
+BENCH_CASE(b_log_test_result_ctx_sink, log_test_result_ctx(&sink_ctx, "Core Voltage", (n & 15) != 0,
+                                                           3.3f, 3.3f))
+BENCH_CASE(b_record_test_result_ctx, record_test_result_ctx(&bench_ctx, "Core Voltage", true,
+                                                            3.29f + (n & 7) * 0.002f))
+BENCH_CASE(b_validation_ctx_stats, bench_consume((uintptr_t)validation_ctx_stats(&bench_ctx,
+                                                                                 "Core Voltage")))
+BENCH_CASE(b_validation_ctx_merge, validation_ctx_merge(&scratch_ctx, &merge_src))
+BENCH_CASE(b_validation_ctx_add_sink, {
+    validation_ctx_add_sink(&scratch_ctx, &null_sink);
+    validation_ctx_remove_sinks(&scratch_ctx);
+})
+BENCH_CASE(b_validation_ctx_flush, {
+    log_test_result_ctx(&sink_ctx, "Core Voltage", true, 3.3f, 3.3f);
+    validation_ctx_flush(&sink_ctx);
+})
+BENCH_CASE(b_print_test_summary_ctx, print_test_summary_ctx(&bench_ctx))
+BENCH_CASE(b_reset_test_counters_ctx, reset_test_counters_ctx(&scratch_ctx))
+BENCH_CASE(b_run_validation_suite_ctx, bench_consume(run_validation_suite_ctx(&scratch_ctx)))
+
+// Validation: default context
+BENCH_CASE(b_log_test_result, log_test_result("Core Voltage", true, 3.3f, 3.3f))
+BENCH_CASE(b_record_test_result, record_test_result("Core Voltage", true, 3.3f))
+BENCH_CASE(b_print_test_summary, print_test_summary())
+BENCH_CASE(b_reset_test_counters, reset_test_counters())
+BENCH_CASE(b_run_validation_suite, bench_consume(run_validation_suite()))
+
+// HAL: GPIO
+BENCH_CASE(b_hal_gpio_init, hal_gpio_init())
+BENCH_CASE(b_hal_gpio_set_direction, hal_gpio_set_direction(n & 7, (n & 8) ? GPIO_OUTPUT : GPIO_INPUT))
+BENCH_CASE(b_hal_gpio_write, hal_gpio_write(0, n & 1))
+BENCH_CASE(b_hal_gpio_read, bench_consume(hal_gpio_read(1)))
+BENCH_CASE(b_hal_gpio_set_direction_mask, hal_gpio_set_direction_mask(0xFF, GPIO_OUTPUT))
+BENCH_CASE(b_hal_gpio_write_port, hal_gpio_write_port((uint32_t)n))
+BENCH_CASE(b_hal_gpio_read_port, bench_consume(hal_gpio_read_port()))
+BENCH_CASE(b_hal_gpio_set_mask, hal_gpio_set_mask(0x0F))
+BENCH_CASE(b_hal_gpio_clear_mask, hal_gpio_clear_mask(0x0F))
+BENCH_CASE(b_hal_gpio_toggle_mask, hal_gpio_toggle_mask(0x0F))
+BENCH_CASE(b_hal_gpio_modify, hal_gpio_modify(0xF0, (uint32_t)n << 4))
+
+// HAL: UART
+BENCH_CASE(b_hal_uart_init, hal_uart_init(115200))
+BENCH_CASE(b_hal_uart_send_char, hal_uart_send_char(uart_bytes[n & 15]))
+BENCH_CASE(b_hal_uart_send_string, hal_uart_send_string("OK\n"))
+BENCH_CASE(b_hal_uart_receive_char, {
+    char c;
+    bench_consume(hal_uart_receive_char(&c));
+})
+BENCH_CASE(b_hal_uart_write, bench_consume(hal_uart_write(&uart_bytes[n & 15], 1)))
+BENCH_CASE(b_hal_uart_tx_drain, bench_consume(hal_uart_tx_drain()))
+BENCH_CASE(b_hal_uart_tx_pending, bench_consume(hal_uart_tx_pending()))
+BENCH_CASE(b_hal_uart_flush, bench_consume(hal_uart_flush(10)))
+BENCH_CASE(b_hal_uart_tx_get_stats, {
+    hal_uart_tx_stats_t stats;
+    hal_uart_tx_get_stats(&stats);
+    bench_consume(stats.bytes_queued);
+})
+
+// Untimed: empty the software TX buffer so hal_uart_write() measures queueing
+static void uart_tx_empty(void* context, uint64_t iterations) {
+    (void)context;
+    (void)iterations;
+    hal_uart_flush(1000);
+}
+
+static void uart_tx_fill(void* context, uint64_t iterations) {
+    (void)context;
+    (void)iterations;
+    hal_uart_flush(1000);
+    for (uint32_t i = 0; i < HAL_UART_TX_BUFFER_SIZE / 16; i++) {
+        hal_uart_write(uart_bytes, 16);
+    }
+}
+
+// HAL: timer and timebase
+BENCH_CASE(b_hal_timer_init, hal_timer_init())
+BENCH_CASE(b_hal_timer_get_count, bench_consume(hal_timer_get_count()))
+BENCH_CASE(b_hal_timer_set_compare, hal_timer_set_compare((uint32_t)n))
+BENCH_CASE(b_hal_timer_get_count64, bench_consume(hal_timer_get_count64()))
+BENCH_CASE(b_hal_timebase_reset, hal_timebase_reset())
+BENCH_CASE(b_hal_delay_us, hal_delay_us(10))
+BENCH_CASE(b_hal_delay_ms, hal_delay_ms(1))
+BENCH_CASE(b_hal_deadline_set_us, {
+    hal_deadline_t deadline;
+    hal_deadline_set_us(&deadline, 100);
+    bench_consume(deadline.expiry);
+})
+BENCH_CASE(b_hal_deadline_set_ms, {
+    hal_deadline_t deadline;
+    hal_deadline_set_ms(&deadline, 1);
+    bench_consume(deadline.expiry);
+})
+
+static hal_deadline_t bench_deadline;
+
+BENCH_CASE(b_hal_deadline_expired, bench_consume(hal_deadline_expired(&bench_deadline)))
+BENCH_CASE(b_hal_deadline_remaining_us, bench_consume(hal_deadline_remaining_us(&bench_deadline)))
+BENCH_CASE(b_hal_deadline_wait, {
+    hal_deadline_t deadline;
+    hal_deadline_set_us(&deadline, 10);
+    hal_deadline_wait(&deadline);
+})
+
+// HAL: frequency counter (10 MHz simulated clock on pin 4)
+BENCH_CASE(b_hal_freq_init, hal_freq_init(4))
+BENCH_CASE(b_hal_freq_measure, {
+    hal_freq_result_t result;
+    bench_consume(hal_freq_measure(HAL_FREQ_GATE, 1000, 1, &result));
+})
+
+// HAL: ADC
+static void scan_done(const uint16_t* buffer, uint32_t channel_mask,
+                      uint32_t samples_per_channel, void* context) {
+    (void)buffer;
+    (void)channel_mask;
+    (void)samples_per_channel;
+    (void)context;
+}
+
+BENCH_CASE(b_hal_adc_init, hal_adc_init())
+BENCH_CASE(b_hal_adc_read_channel, bench_consume(hal_adc_read_channel(n & 3)))
+BENCH_CASE(b_hal_adc_scan_set_callback, hal_adc_scan_set_callback((n & 1) ? scan_done : NULL, NULL))
+BENCH_CASE(b_hal_adc_scan_start, {
+    bench_consume(hal_adc_scan_start(0x0F, 1, scan_buffer));
+    hal_adc_scan_wait();
+})
+BENCH_CASE(b_hal_adc_scan_poll, bench_consume(hal_adc_scan_poll()))
+BENCH_CASE(b_hal_adc_scan_busy, bench_consume(hal_adc_scan_busy()))
+BENCH_CASE(b_hal_adc_scan_samples, bench_consume((uintptr_t)hal_adc_scan_samples(n & 3)))
+BENCH_CASE(b_hal_adc_stream_start, {
+    hal_adc_stream_config_t config = {0x03, 64, 3, stream_storage};
+    bench_consume(hal_adc_stream_start(&config));
+    hal_adc_stream_stop();
+})
+BENCH_CASE(b_hal_adc_stream_service, {
+    bench_consume(hal_adc_stream_service());
+    const hal_adc_block_t* block = hal_adc_stream_acquire();
+    if (block) hal_adc_stream_release(block);
+})
+BENCH_CASE(b_hal_adc_stream_overruns, bench_consume(hal_adc_stream_overruns()))
+BENCH_CASE(b_hal_adc_stream_dropped_samples, bench_consume(hal_adc_stream_dropped_samples()))
+
+// HAL: system and logging
+BENCH_CASE(b_hal_system_init, hal_system_init())
+BENCH_CASE(b_hal_log_set_level, hal_log_set_level(HAL_LOG_LEVEL_INFO))
+BENCH_CASE(b_hal_log_get_level, bench_consume(hal_log_get_level()))
+
+static void bench_validation(bench_suite_t* suite) {
+    for (uint32_t i = 0; i < BENCH_BATCH; i++) {
+        batch_voltage[i] = 1.75f + (float)(i % 11) * 0.01f;
+        batch_current[i] = 0.5f + (float)(i % 7) * 0.1f;
+        batch_frequency[i] = 99400000u + (i % 13) * 100000u;
+    }
+    
+    validation_ctx_init(&bench_ctx, NULL);
+    validation_ctx_init(&sink_ctx, NULL);
+    validation_ctx_init(&merge_src, NULL);
+    validation_ctx_init(&scratch_ctx, NULL);
+    for (int i = 0; i < 8; i++) {
+        record_test_result_ctx(&merge_src, i & 1 ? "IO Voltage" : "Core Voltage", true, 1.8f);
+    }
+    
+    FILE* null_stream = fopen("/dev/null", "wb");
+    if (null_stream) {
+        validation_sink_open(&null_sink, VALIDATION_SINK_BINARY, null_stream, 0);
+        validation_ctx_add_sink(&sink_ctx, &null_sink);
+    }
+    
+    bench_case(suite, "validate_voltage", b_validate_voltage, NULL);
+    bench_case(suite, "validate_frequency", b_validate_frequency, NULL);
+    bench_case(suite, "validate_power", b_validate_power, NULL);
+    bench_case(suite, "validate_frequency_ppm", b_validate_frequency_ppm, NULL);
+    bench_case(suite, "frequency_error_ppm", b_frequency_error_ppm, NULL);
+    bench_case(suite, "validate_limits", b_validate_limits, NULL);
+    bench_case(suite, "validate_voltage_batch (1024)", b_validate_voltage_batch, NULL);
+    bench_case(suite, "validate_frequency_batch (1024)", b_validate_frequency_batch, NULL);
+    bench_case(suite, "validate_power_batch (1024)", b_validate_power_batch, NULL);
+    bench_case(suite, "validation_batch_isa", b_validation_batch_isa, NULL);
+    bench_case(suite, "validation_ctx_init", b_validation_ctx_init, NULL);
+    bench_case(suite, "validation_default_ctx", b_validation_default_ctx, NULL);
+    bench_case(suite, "validation_ctx_total", b_validation_ctx_total, NULL);
+    bench_case(suite, "validation_ctx_passed", b_validation_ctx_passed, NULL);
+    bench_case(suite, "log_test_result_ctx (printf)", b_log_test_result_ctx, NULL);
+    bench_case(suite, "log_test_result_ctx (binary sink)", b_log_test_result_ctx_sink, NULL);
+    bench_case(suite, "record_test_result_ctx", b_record_test_result_ctx, NULL);
+    bench_case(suite, "validation_ctx_stats", b_validation_ctx_stats, NULL);
+    bench_case(suite, "validation_ctx_merge", b_validation_ctx_merge, NULL);
+    bench_case(suite, "validation_ctx_add_sink+remove_sinks", b_validation_ctx_add_sink, NULL);
+    bench_case(suite, "validation_ctx_flush (1 record)", b_validation_ctx_flush, NULL);
+    bench_case(suite, "print_test_summary_ctx", b_print_test_summary_ctx, NULL);
+    bench_case(suite, "reset_test_counters_ctx", b_reset_test_counters_ctx, NULL);
+    bench_case(suite, "run_validation_suite_ctx", b_run_validation_suite_ctx, NULL);
+    bench_case(suite, "log_test_result", b_log_test_result, NULL);
+    bench_case(suite, "record_test_result", b_record_test_result, NULL);
+    bench_case(suite, "print_test_summary", b_print_test_summary, NULL);
+    bench_case(suite, "reset_test_counters", b_reset_test_counters, NULL);
+    bench_case(suite, "run_validation_suite", b_run_validation_suite, NULL);
+    
+    validation_ctx_remove_sinks(&sink_ctx);
+    if (null_stream) {
+        validation_sink_close(&null_sink);
+        fclose(null_stream);
+    }
+}
+
+static void bench_hal(bench_suite_t* suite) {
+    bench_case(suite, "hal_gpio_init", b_hal_gpio_init, NULL);
+    bench_case(suite, "hal_gpio_set_direction", b_hal_gpio_set_direction, NULL);
+    bench_case(suite, "hal_gpio_write", b_hal_gpio_write, NULL);
+    bench_case(suite, "hal_gpio_read", b_hal_gpio_read, NULL);
+    bench_case(suite, "hal_gpio_set_direction_mask", b_hal_gpio_set_direction_mask, NULL);
+    bench_case(suite, "hal_gpio_write_port", b_hal_gpio_write_port, NULL);
+    bench_case(suite, "hal_gpio_read_port", b_hal_gpio_read_port, NULL);
+    bench_case(suite, "hal_gpio_set_mask", b_hal_gpio_set_mask, NULL);
+    bench_case(suite, "hal_gpio_clear_mask", b_hal_gpio_clear_mask, NULL);
+    bench_case(suite, "hal_gpio_toggle_mask", b_hal_gpio_toggle_mask, NULL);
+    bench_case(suite, "hal_gpio_modify", b_hal_gpio_modify, NULL);
+    
+    bench_case(suite, "hal_uart_init", b_hal_uart_init, NULL);
+    bench_case(suite, "hal_uart_send_char", b_hal_uart_send_char, NULL);
+    bench_case(suite, "hal_uart_send_string (3 B)", b_hal_uart_send_string, NULL);
+    bench_case(suite, "hal_uart_receive_char", b_hal_uart_receive_char, NULL);
+    bench_case_t uart_write = {"hal_uart_write (1 B)", b_hal_uart_write, uart_tx_empty, NULL,
+                               HAL_UART_TX_BUFFER_SIZE / 2};
+    bench_run(suite, &uart_write);
+    bench_case_t uart_drain = {"hal_uart_tx_drain", b_hal_uart_tx_drain, uart_tx_fill, NULL, 0};
+    bench_run(suite, &uart_drain);
+    bench_case(suite, "hal_uart_tx_pending", b_hal_uart_tx_pending, NULL);
+    bench_case_t uart_flush = {"hal_uart_flush (idle)", b_hal_uart_flush, uart_tx_empty, NULL, 0};
+    bench_run(suite, &uart_flush);
+    bench_case(suite, "hal_uart_tx_get_stats", b_hal_uart_tx_get_stats, NULL);
+    
+    bench_case(suite, "hal_timer_init", b_hal_timer_init, NULL);
+    bench_case(suite, "hal_timer_get_count", b_hal_timer_get_count, NULL);
+    bench_case(suite, "hal_timer_set_compare", b_hal_timer_set_compare, NULL);
+    bench_case(suite, "hal_timer_get_count64", b_hal_timer_get_count64, NULL);
+    bench_case(suite, "hal_timebase_reset", b_hal_timebase_reset, NULL);
+    bench_case(suite, "hal_delay_us (10 us)", b_hal_delay_us, NULL);
+    bench_case(suite, "hal_delay_ms (1 ms)", b_hal_delay_ms, NULL);
+    bench_case(suite, "hal_deadline_set_us", b_hal_deadline_set_us, NULL);
+    bench_case(suite, "hal_deadline_set_ms", b_hal_deadline_set_ms, NULL);
+    hal_deadline_set_ms(&bench_deadline, 1000);
+    bench_case(suite, "hal_deadline_expired", b_hal_deadline_expired, NULL);
+    bench_case(suite, "hal_deadline_remaining_us", b_hal_deadline_remaining_us, NULL);
+    bench_case(suite, "hal_deadline_wait (10 us)", b_hal_deadline_wait, NULL);
+    
+    hal_sim_clock_set(4, 10000000000ull);
+    bench_case(suite, "hal_freq_init", b_hal_freq_init, NULL);
+    bench_case(suite, "hal_freq_measure (1 ms gate)", b_hal_freq_measure, NULL);
+    
+    bench_case(suite, "hal_adc_init", b_hal_adc_init, NULL);
+    bench_case(suite, "hal_adc_read_channel", b_hal_adc_read_channel, NULL);
+    bench_case(suite, "hal_adc_scan_set_callback", b_hal_adc_scan_set_callback, NULL);
+    bench_case(suite, "hal_adc_scan_start+wait (4 ch)", b_hal_adc_scan_start, NULL);
+    bench_case(suite, "hal_adc_scan_poll", b_hal_adc_scan_poll, NULL);
+    bench_case(suite, "hal_adc_scan_busy", b_hal_adc_scan_busy, NULL);
+    bench_case(suite, "hal_adc_scan_samples", b_hal_adc_scan_samples, NULL);
+    bench_case(suite, "hal_adc_stream_start+stop", b_hal_adc_stream_start, NULL);
+    hal_adc_stream_config_t stream_config = {0x03, 64, 3, stream_storage};
+    hal_adc_stream_start(&stream_config);
+    bench_case(suite, "hal_adc_stream_service+acquire+release", b_hal_adc_stream_service, NULL);
+    hal_adc_stream_stop();
+    bench_case(suite, "hal_adc_stream_overruns", b_hal_adc_stream_overruns, NULL);
+    bench_case(suite, "hal_adc_stream_dropped_samples", b_hal_adc_stream_dropped_samples, NULL);
+    
+    bench_case(suite, "hal_system_init", b_hal_system_init, NULL);
+    bench_case(suite, "hal_log_set_level", b_hal_log_set_level, NULL);
+    bench_case(suite, "hal_log_get_level", b_hal_log_get_level, NULL);
+}
+
+int main(int argc, char* argv[]) {
+    static bench_suite_t suite;
+    if (bench_init(&suite, "validation_lib + fpga_hal", argc, argv) != 0) {
+        return 2;
+    }
+    
+    hal_log_set_level(HAL_LOG_LEVEL_ERROR);
+    hal_system_init();
+    fprintf(stderr, "Register backend: %s, batch ISA: %s, limits table: %s\n",
+            hal_backend_name(), validation_batch_isa(),
+            validate_limits("io_voltage", 1.8) ? "loaded" : "none");
+    
+    bench_validation(&suite);
+    bench_hal(&suite);
+    
+    int result = bench_finish(&suite);
+    return result == 0 ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "validation_lib.h"
+#include "perf_clock.h"
+
+// Batch validators vs. a loop over the scalar ones, on a synthetic capture
+// with roughly half the samples out of tolerance. Each variant runs
+// BENCH_ROUNDS times and the fastest round is reported; the bitmaps and
+// pass counts must agree or the benchmark fails.
+
+#define BENCH_DEFAULT_SAMPLES (1u << 22)
+#define BENCH_ROUNDS 5
+
+static uint32_t bench_rng = 12345;
+
+static uint32_t bench_next(void) {
+    bench_rng = bench_rng * 1664525u + 1013904223u;
+    return bench_rng;
+}
+
+static float bench_uniform(float low, float high) {
+    return low + (high - low) * (float)(bench_next() >> 8) / 16777216.0f;
+}
+
+static size_t scalar_voltage(const float* v, size_t n, uint8_t* bitmap) {
+    size_t passed = 0;
+    memset(bitmap, 0, (n + 7) / 8);
+    for (size_t i = 0; i < n; i++) {
+        if (validate_voltage(v[i], 3.30f, 0.10f)) {
+            bitmap[i >> 3] |= (uint8_t)(1u << (i & 7));
+            passed++;
+        }
+    }
+    return passed;
+}
+
+static size_t scalar_frequency(const uint32_t* f, size_t n, uint8_t* bitmap) {
+    size_t passed = 0;
+    memset(bitmap, 0, (n + 7) / 8);
+    for (size_t i = 0; i < n; i++) {
+        if (validate_frequency(f[i], 100000000u, 500000u)) {
+            bitmap[i >> 3] |= (uint8_t)(1u << (i & 7));
+            passed++;
+        }
+    }
+    return passed;
+}
+
+static size_t scalar_power(const float* v, const float* c, size_t n, uint8_t* bitmap) {
+    size_t passed = 0;
+    memset(bitmap, 0, (n + 7) / 8);
+    for (size_t i = 0; i < n; i++) {
+        if (validate_power(v[i], c[i], 4.0f)) {
+            bitmap[i >> 3] |= (uint8_t)(1u << (i & 7));
+            passed++;
+        }
+    }
+    return passed;
+}
+
+static void report(const char* name, size_t n, perf_ticks_t scalar, perf_ticks_t batch) {
+    double scalar_ns = (double)perf_clock_to_ns(scalar) / (double)n;
+    double batch_ns = (double)perf_clock_to_ns(batch) / (double)n;
+    printf("%-10s scalar %6.3f ns/sample  batch %6.3f ns/sample  speedup %5.1fx\n",
+           name, scalar_ns, batch_ns, batch_ns > 0.0 ? scalar_ns / batch_ns : 0.0);
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = BENCH_DEFAULT_SAMPLES;
+    if (argc > 1) {
+        n = (size_t)strtoul(argv[1], NULL, 0);
+    }
+    if (n == 0) {
+        fprintf(stderr, "usage: %s [samples]\n", argv[0]);
+        return 1;
+    }
+    
+    size_t bitmap_bytes = (n + 7) / 8;
+    float* voltage = malloc(n * sizeof(float));
+    float* current = malloc(n * sizeof(float));
+    uint32_t* frequency = malloc(n * sizeof(uint32_t));
+    uint8_t* scalar_bitmap = malloc(bitmap_bytes);
+    uint8_t* batch_bitmap = malloc(bitmap_bytes);
+    if (!voltage || !current || !frequency || !scalar_bitmap || !batch_bitmap) {
+        fprintf(stderr, "Out of memory for %zu samples\n", n);
+        return 1;
+    }
+    
+    for (size_t i = 0; i < n; i++) {
+        voltage[i] = bench_uniform(3.10f, 3.50f);
+        current[i] = bench_uniform(1.00f, 1.40f);
+        frequency[i] = 99000000u + bench_next() % 2000000u;
+    }
+    
+    perf_clock_calibrate();
+    printf("Batch validation benchmark: %zu samples, %s path, %s clock\n",
+           n, validation_batch_isa(), perf_clock_source());
+    
+    int failures = 0;
+    for (int kind = 0; kind < 3; kind++) {
+        perf_ticks_t best_scalar = UINT64_MAX;
+        perf_ticks_t best_batch = UINT64_MAX;
+        size_t scalar_passed = 0;
+        size_t batch_passed = 0;
+        
+        for (int round = 0; round < BENCH_ROUNDS; round++) {
+            perf_ticks_t start = perf_clock_now();
+            if (kind == 0) {
+                scalar_passed = scalar_voltage(voltage, n, scalar_bitmap);
+            } else if (kind == 1) {
+                scalar_passed = scalar_frequency(frequency, n, scalar_bitmap);
+            } else {
+                scalar_passed = scalar_power(voltage, current, n, scalar_bitmap);
+            }
+            perf_ticks_t elapsed = perf_clock_now() - start;
+            if (elapsed < best_scalar) {
+                best_scalar = elapsed;
+            }
+            
+            start = perf_clock_now();
+            if (kind == 0) {
+                batch_passed = validate_voltage_batch(voltage, n, 3.30f, 0.10f, batch_bitmap);
+            } else if (kind == 1) {
+                batch_passed = validate_frequency_batch(frequency, n, 100000000u, 500000u,
+                                                        batch_bitmap);
+            } else {
+                batch_passed = validate_power_batch(voltage, current, n, 4.0f, batch_bitmap);
+            }
+            elapsed = perf_clock_now() - start;
+            if (elapsed < best_batch) {
+                best_batch = elapsed;
+            }
+        }
+        
+        static const char* names[] = { "voltage", "frequency", "power" };
+        report(names[kind], n, best_scalar, best_batch);
+        
+        if (scalar_passed != batch_passed ||
+            memcmp(scalar_bitmap, batch_bitmap, bitmap_bytes) != 0) {
+            printf("  MISMATCH: scalar passed %zu, batch passed %zu\n",
+                   scalar_passed, batch_passed);
+            failures++;
+        }
+    }
+    
+    free(voltage);
+    free(current);
+    free(frequency);
+    free(scalar_bitmap);
+    free(batch_bitmap);
+    return failures ? 1 : 0;
+}
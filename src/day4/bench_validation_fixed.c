@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include <stdint.h>
+#include "validation_lib.h"
+#include "perf_clock.h"
+
+// Per-call cost of the float and integer validation paths, in profiling
+// clock ticks: CPU cycles on RISC-V (where the float path is soft-float),
+// nanoseconds on the host.
+
+#define BENCH_ITERATIONS 100000
+
+static volatile uint32_t bench_sink;
+
+static void report(const char* name, perf_ticks_t ticks) {
+    perf_ticks_t overhead = perf_clock_overhead();
+    ticks = (ticks > overhead) ? ticks - overhead : 0;
+    printf("%-28s %8.2f ticks/call\n", name, (double)ticks / BENCH_ITERATIONS);
+}
+
+int main(void) {
+    perf_clock_calibrate();
+    printf("Validation path benchmark (%s, %s build)\n", perf_clock_source(),
+           VALIDATION_FIXED_POINT ? "fixed-point" : "float");
+    
+    uint32_t passed = 0;
+    perf_ticks_t start = perf_clock_now();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        passed += validate_voltage((float)(i & 4095) * (3.3f / 4095.0f), 1.65f, 0.5f);
+    }
+    report("validate_voltage (float)", perf_clock_now() - start);
+    
+    start = perf_clock_now();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        passed += validate_voltage_mv((int32_t)(i & 4095), 1650, 500);
+    }
+    report("validate_voltage_mv", perf_clock_now() - start);
+    
+    start = perf_clock_now();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        passed += validate_voltage_q16((q16_16_t)(i & 4095) << 4, Q16_FROM_MV(1650),
+                                       Q16_FROM_MV(500));
+    }
+    report("validate_voltage_q16", perf_clock_now() - start);
+    
+    start = perf_clock_now();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        passed += validate_power(3.3f, (float)(i & 1023) * (1.0f / 512.0f), 4.0f);
+    }
+    report("validate_power (float)", perf_clock_now() - start);
+    
+    start = perf_clock_now();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        passed += validate_power_mv_ua(3300, (int32_t)(i & 1023) * 1953, 4000000);
+    }
+    report("validate_power_mv_ua", perf_clock_now() - start);
+    
+    start = perf_clock_now();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        passed += validate_power_q16(Q16_FROM_MV(3300), (q16_16_t)(i & 1023) << 7,
+                                     Q16_FROM_INT(4));
+    }
+    report("validate_power_q16", perf_clock_now() - start);
+    
+    start = perf_clock_now();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        float voltage = ((i & 4095) * 3.3f) / 4095.0f;
+        passed += (voltage > 1.65f);
+    }
+    report("adc conversion (float)", perf_clock_now() - start);
+    
+    start = perf_clock_now();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        passed += (adc_to_millivolts((uint16_t)(i & 4095)) > 1650);
+    }
+    report("adc_to_millivolts", perf_clock_now() - start);
+    
+    start = perf_clock_now();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        passed += (adc_to_q16((uint16_t)(i & 4095)) > Q16_FROM_MV(1650));
+    }
+    report("adc_to_q16", perf_clock_now() - start);
+    
+    bench_sink = passed;
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include "binning.h"
+#include <stdio.h>
+#include <string.h>
+
+#if !defined(__riscv)
+#define BINNING_HAVE_THREADS 1
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define BINNING_MAX_THREADS 64
+
+int binning_table_init(binning_table_t* table, uint32_t param_count,
+                       const char* fail_name, uint16_t fail_hard_bin, uint16_t fail_soft_bin) {
+    if (param_count == 0 || param_count > BINNING_MAX_PARAMETERS) {
+        fprintf(stderr, "binning: %u parameters, supported 1..%d\n",
+                (unsigned)param_count, BINNING_MAX_PARAMETERS);
+        return -1;
+    }
+    
+    table->param_count = param_count;
+    table->rule_count = 0;
+    table->bins[0].name = fail_name;
+    table->bins[0].hard_bin = fail_hard_bin;
+    table->bins[0].soft_bin = fail_soft_bin;
+    return 0;
+}
+
+int binning_add_rule(binning_table_t* table, const char* name, uint16_t hard_bin, uint16_t soft_bin,
+                     const float* lo, const float* hi, const float* guard) {
+    if (table->rule_count >= BINNING_MAX_RULES) {
+        fprintf(stderr, "binning: more than %d rules\n", BINNING_MAX_RULES);
+        return -1;
+    }
+    
+    uint32_t rule = table->rule_count;
+    float* rule_lo = &table->lo[rule * table->param_count];
+    float* rule_hi = &table->hi[rule * table->param_count];
+    for (uint32_t p = 0; p < table->param_count; p++) {
+        float band = guard ? guard[p] : 0.0f;
+        rule_lo[p] = lo[p] + band;
+        rule_hi[p] = hi[p] - band;
+    }
+    
+    // The fail bin always sits just past the last rule
+    table->bins[rule + 1] = table->bins[rule];
+    table->bins[rule].name = name;
+    table->bins[rule].hard_bin = hard_bin;
+    table->bins[rule].soft_bin = soft_bin;
+    table->rule_count++;
+    return 0;
+}
+
+// Every rule is evaluated in full and folded into a match mask; the first
+// set bit is the winning rule. No branch depends on the measurements.
+uint32_t binning_classify(const binning_table_t* table, const float* measurements) {
+    const uint32_t params = table->param_count;
+    uint64_t matched = 0;
+    
+    for (uint32_t rule = 0; rule < table->rule_count; rule++) {
+        const float* lo = &table->lo[rule * params];
+        const float* hi = &table->hi[rule * params];
+        uint32_t inside = 1;
+        for (uint32_t p = 0; p < params; p++) {
+            inside &= (uint32_t)(measurements[p] >= lo[p]) & (uint32_t)(measurements[p] <= hi[p]);
+        }
+        matched |= (uint64_t)inside << rule;
+    }
+    
+    // A select, not a branch: compiles to a conditional move
+    return matched ? (uint32_t)__builtin_ctzll(matched) : table->rule_count;
+}
+
+typedef struct {
+    const binning_table_t* table;
+    const float* measurements;
+    size_t first;
+    size_t count;
+    uint16_t* hard_bins;
+    uint16_t* soft_bins;
+    uint64_t counts[BINNING_MAX_RULES + 1];
+} binning_chunk_t;
+
+static void* binning_chunk_run(void* arg) {
+    binning_chunk_t* chunk = (binning_chunk_t*)arg;
+    const binning_table_t* table = chunk->table;
+    const size_t stride = table->param_count;
+    
+    memset(chunk->counts, 0, sizeof(chunk->counts));
+    for (size_t i = chunk->first; i < chunk->first + chunk->count; i++) {
+        uint32_t bin = binning_classify(table, &chunk->measurements[i * stride]);
+        chunk->counts[bin]++;
+        if (chunk->hard_bins) {
+            chunk->hard_bins[i] = table->bins[bin].hard_bin;
+        }
+        if (chunk->soft_bins) {
+            chunk->soft_bins[i] = table->bins[bin].soft_bin;
+        }
+    }
+    return NULL;
+}
+
+static uint32_t binning_thread_count(uint32_t requested, size_t device_count) {
+#if BINNING_HAVE_THREADS
+    if (requested == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        requested = (online > 0) ? (uint32_t)online : 1;
+    }
+    if (requested > BINNING_MAX_THREADS) {
+        requested = BINNING_MAX_THREADS;
+    }
+    // Small datasets are not worth a thread start
+    size_t useful = device_count / 4096 + 1;
+    return (requested > useful) ? (uint32_t)useful : requested;
+#else
+    (void)requested;
+    (void)device_count;
+    return 1;
+#endif
+}
+
+int binning_run(const binning_table_t* table, const float* measurements, size_t device_count,
+                uint32_t threads, uint16_t* hard_bins, uint16_t* soft_bins,
+                binning_result_t* result) {
+    binning_chunk_t chunks[BINNING_MAX_THREADS];
+    uint32_t thread_count = binning_thread_count(threads, device_count);
+    size_t per_thread = device_count / thread_count;
+    size_t remainder = device_count % thread_count;
+    size_t first = 0;
+    
+    for (uint32_t t = 0; t < thread_count; t++) {
+        chunks[t].table = table;
+        chunks[t].measurements = measurements;
+        chunks[t].first = first;
+        chunks[t].count = per_thread + (t < remainder ? 1 : 0);
+        chunks[t].hard_bins = hard_bins;
+        chunks[t].soft_bins = soft_bins;
+        first += chunks[t].count;
+    }
+    
+#if BINNING_HAVE_THREADS
+    pthread_t workers[BINNING_MAX_THREADS];
+    uint32_t started = 1;
+    
+    // Chunk 0 runs on the calling thread
+    for (uint32_t t = 1; t < thread_count; t++) {
+        if (pthread_create(&workers[t], NULL, binning_chunk_run, &chunks[t]) != 0) {
+            break;
+        }
+        started++;
+    }
+    binning_chunk_run(&chunks[0]);
+    for (uint32_t t = 1; t < started; t++) {
+        pthread_join(workers[t], NULL);
+    }
+    // Anything that failed to start runs here instead
+    for (uint32_t t = started; t < thread_count; t++) {
+        binning_chunk_run(&chunks[t]);
+    }
+#else
+    binning_chunk_run(&chunks[0]);
+#endif
+    
+    if (result) {
+        memset(result, 0, sizeof(*result));
+        result->device_count = device_count;
+        result->threads_used = thread_count;
+        for (uint32_t t = 0; t < thread_count; t++) {
+            for (uint32_t bin = 0; bin <= table->rule_count; bin++) {
+                result->counts[bin] += chunks[t].counts[bin];
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+#ifndef BINNING_H
+#define BINNING_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Device binning: each device is a vector of measurements (one float per
+// parameter, devices stored row after row). Ordered rules give a window per
+// parameter; a device lands in the first rule whose windows all contain
+// its values, or in the fail bin when none do. Rules are evaluated as a
+// table without data-dependent branches, and binning_run() splits large
+// datasets across cores.
+//
+// Guard bands tighten a rule's window at build time. Speed/voltage binning
+// with guard bands is expressed as ordered rules, e.g.
+//   1. Bin 1 fast      fmax >= 1.2 GHz, Vmin window, with guard band
+//   2. Bin 1 marginal  same limits without the guard band (soft bin only)
+//   3. Bin 2 slow      fmax >= 1.0 GHz ...
+// Use -INFINITY / INFINITY for limits a rule does not care about. NaN
+// measurements match no rule.
+
+#define BINNING_MAX_PARAMETERS 32
+#define BINNING_MAX_RULES      64
+
+typedef struct {
+    const char* name;
+    uint16_t hard_bin;
+    uint16_t soft_bin;
+} binning_bin_t;
+
+typedef struct {
+    uint32_t param_count;
+    uint32_t rule_count;
+    // Effective (guard-banded) windows, rule-major: [rule * param_count + param]
+    float lo[BINNING_MAX_RULES * BINNING_MAX_PARAMETERS];
+    float hi[BINNING_MAX_RULES * BINNING_MAX_PARAMETERS];
+    // bins[rule_count] is the fail bin
+    binning_bin_t bins[BINNING_MAX_RULES + 1];
+} binning_table_t;
+
+typedef struct {
+    uint64_t device_count;
+    uint64_t counts[BINNING_MAX_RULES + 1];    // Per rule; [rule_count] = fail bin
+    uint32_t threads_used;
+} binning_result_t;
+
+int binning_table_init(binning_table_t* table, uint32_t param_count,
+                       const char* fail_name, uint16_t fail_hard_bin, uint16_t fail_soft_bin);
+
+// lo/hi/guard hold param_count values; guard may be NULL
+int binning_add_rule(binning_table_t* table, const char* name, uint16_t hard_bin, uint16_t soft_bin,
+                     const float* lo, const float* hi, const float* guard);
+
+// Bin one device; returns its rule index (rule_count for the fail bin)
+uint32_t binning_classify(const binning_table_t* table, const float* measurements);
+
+// Bin device_count devices. hard_bins/soft_bins (either may be NULL) receive
+// one entry per device. threads = 0 uses every online core; targets
+// without threads always run on the calling core.
+int binning_run(const binning_table_t* table, const float* measurements, size_t device_count,
+                uint32_t threads, uint16_t* hard_bins, uint16_t* soft_bins,
+                binning_result_t* result);
+
+#endif // BINNING_H
@@ -2,6 +2,8 @@
 #include <stdint.h>
 #include "fpga_hal.h"
 #include "validation_lib.h"
+#include "perf_clock.h"
+#include "power_analyzer.h"
 
 // Platform detection
 #ifdef __riscv
@@ -12,31 +14,31 @@
     #define PLATFORM_RISCV 0
 #endif
 
-// Cross-platform timing functions
-static uint32_t get_system_tick(void) {
-#ifdef __riscv
-    return hal_timer_get_count();
-#else
-    // Simulate timer for native builds
-    static uint32_t sim_tick = 0;
-    return ++sim_tick;
-#endif
-}
-
-// Performance measurement
+// Performance measurement on the profiling clock (cycle CSR on RISC-V,
+// CLOCK_MONOTONIC_RAW on native), with the clock's own read cost removed
 typedef struct {
-    uint32_t start_tick;
-    uint32_t end_tick;
-    uint32_t duration;
+    perf_ticks_t start_tick;
+    perf_ticks_t end_tick;
+    perf_ticks_t duration;
+    uint64_t duration_ns;
 } perf_counter_t;
 
 void perf_start(perf_counter_t* counter) {
-    counter->start_tick = get_system_tick();
+    counter->start_tick = perf_clock_now();
 }
 
 void perf_end(perf_counter_t* counter) {
-    counter->end_tick = get_system_tick();
-    counter->duration = counter->end_tick - counter->start_tick;
+    counter->end_tick = perf_clock_now();
+    
+    perf_ticks_t elapsed = counter->end_tick - counter->start_tick;
+    perf_ticks_t overhead = perf_clock_overhead();
+    counter->duration = (elapsed > overhead) ? elapsed - overhead : 0;
+    counter->duration_ns = perf_clock_to_ns(counter->duration);
+}
+
+static void perf_report(const char* label, const perf_counter_t* counter) {
+    printf("%s: %llu ns (%llu ticks)\n", label,
+           (unsigned long long)counter->duration_ns, (unsigned long long)counter->duration);
 }
 
 // Cross-platform validation test
@@ -47,18 +49,23 @@ int run_cross_platform_test(void) {
     printf("Platform: %s\n", PLATFORM_NAME);
     printf("RISC-V Target: %s\n", PLATFORM_RISCV ? "Yes" : "No");
     
+    perf_clock_calibrate();
+    printf("Profiling clock: %s (overhead %llu ticks = %llu ns)\n", perf_clock_source(),
+           (unsigned long long)perf_clock_overhead(),
+           (unsigned long long)perf_clock_to_ns(perf_clock_overhead()));
+    
     // Initialize hardware abstraction layer
     perf_start(&perf);
     hal_system_init();
     perf_end(&perf);
-    printf("HAL Init Time: %d ticks\n", perf.duration);
+    perf_report("HAL Init Time", &perf);
     
     // Run validation tests
     printf("\n--- Running Validation Suite ---\n");
     perf_start(&perf);
     int validation_result = run_validation_suite();
     perf_end(&perf);
-    printf("Validation Time: %d ticks\n", perf.duration);
+    perf_report("Validation Time", &perf);
     
     // Test GPIO functionality
     printf("\n--- Testing GPIO Operations ---\n");
@@ -73,32 +80,87 @@ int run_cross_platform_test(void) {
     }
     
     perf_end(&perf);
-    printf("GPIO Test Time: %d ticks\n", perf.duration);
+    perf_report("GPIO Test Time", &perf);
     
     // Test ADC readings (simulated on native)
     printf("\n--- Testing ADC Readings ---\n");
     perf_start(&perf);
     
+    // One scan of channels 0-3; conversions stream back-to-back
+    uint16_t adc_samples[4];
+    hal_adc_scan_start(0x0F, 1, adc_samples);
+    hal_adc_scan_wait();
+    
     for (int channel = 0; channel < 4; channel++) {
-        uint16_t adc_value = hal_adc_read_channel(channel);
+        uint16_t adc_value = hal_adc_scan_samples(channel)[0];
         
+#if VALIDATION_FIXED_POINT
+        // No FPU: convert and validate in millivolts; float only for the log line
+        int32_t millivolts = adc_to_millivolts(adc_value);
+        bool voltage_valid = validate_voltage_mv(millivolts, 1650, 1650); // 0-3.3V range
+        log_test_result("ADC Channel", voltage_valid, millivolts / 1000.0f, 1.65f);
+#else
         // Convert ADC reading to voltage (assuming 3.3V reference, 12-bit ADC)
         float voltage = (adc_value * 3.3f) / 4095.0f;
         
         // Validate voltage is within reasonable range
         bool voltage_valid = validate_voltage(voltage, 1.65f, 1.65f); // 0-3.3V range
         log_test_result("ADC Channel", voltage_valid, voltage, 1.65f);
+#endif
+    }
+    
+    perf_end(&perf);
+    perf_report("ADC Test Time", &perf);
+    
+    // Rail power from streamed V (channel 0) and I (channel 1, 1 A/V shunt amp)
+    printf("\n--- Testing Rail Power ---\n");
+    perf_start(&perf);
+    
+    static uint16_t power_storage[3 * 256 * 2];
+    static float power_window[100];
+    power_analyzer_config_t power_config = {
+        100000.0, 100, power_window,          // Two 5 us conversions per frame; 1 ms window
+        2.5f, 2.0f, 0.0f,                     // Peak and window-average limits
+        3.3f / 4095.0f, 3.3f / 4095.0f, NULL, NULL
+    };
+    power_analyzer_t power;
+    power_analyzer_init(&power, &power_config);
+    
+    hal_adc_stream_config_t stream_config = {0x03, 256, 3, power_storage};
+    hal_adc_stream_start(&stream_config);
+    for (uint32_t blocks = 0; blocks < 8;) {
+        hal_adc_stream_service();
+        const hal_adc_block_t* block = hal_adc_stream_acquire();
+        if (!block) continue;
+        
+        power_analyzer_process_adc(&power, block->samples, block->frame_count,
+                                   block->channel_count, 0, 1);
+        hal_adc_stream_release(block);
+        blocks++;
     }
+    hal_adc_stream_stop();
+    power_analyzer_finish(&power);
+    
+    power_summary_t power_summary;
+    power_analyzer_summary(&power, &power_summary);
+    printf("%llu samples: average %.3f W, peak %.3f W, energy %.3f mJ\n",
+           (unsigned long long)power_summary.samples, power_summary.average_w,
+           power_summary.peak_w, power_summary.energy_j * 1000.0);
+    bool power_valid = power_summary.violations[POWER_VIOLATION_PEAK] == 0 &&
+                       power_summary.violations[POWER_VIOLATION_WINDOW_HIGH] == 0;
+    log_test_result("Rail Power", power_valid, (float)power_summary.window_max_w, 2.0f);
     
     perf_end(&perf);
-    printf("ADC Test Time: %d ticks\n", perf.duration);
+    perf_report("Power Test Time", &perf);
     
     // Platform-specific tests
     if (PLATFORM_RISCV) {
         printf("\n--- RISC-V Specific Tests ---\n");
         
-        // Test UART communication
-        hal_uart_send_string("RISC-V FPGA validation complete\n");
+        // Test UART communication; the message drains while the timer test runs
+        const char uart_message[] = "RISC-V FPGA validation complete\n";
+        hal_uart_write(uart_message, sizeof(uart_message) - 1);
+        hal_uart_tx_drain();
         
         // Test timer precision
         uint32_t timer_start = hal_timer_get_count();
@@ -108,6 +170,10 @@ int run_cross_platform_test(void) {
         
         printf("Timer precision test: %d ticks for 100ms delay\n", measured_delay);
         
+        if (hal_uart_flush(100) != 0) {
+            printf("UART flush timed out\n");
+        }
+        
     } else {
         printf("\n--- Native Simulation Tests ---\n");
         printf("Running in simulation mode - hardware tests skipped\n");
@@ -1,51 +1,31 @@
 #include "fpga_hal.h"
-#include <stdio.h>
-
-// Hardware register base addresses
-#define FPGA_BASE_ADDR    0x40000000
-#define GPIO_BASE_OFFSET  0x00000000
-#define UART_BASE_OFFSET  0x00001000
-#define TIMER_BASE_OFFSET 0x00002000
-#define ADC_BASE_OFFSET   0x00003000
-
-// GPIO register offsets
-#define GPIO_DATA_REG     0x00
-#define GPIO_DIR_REG      0x04
-#define GPIO_INT_REG      0x08
-
-// UART register offsets
-#define UART_DATA_REG     0x00
-#define UART_STATUS_REG   0x04
-#define UART_CONTROL_REG  0x08
-
-// Timer register offsets
-#define TIMER_COUNT_REG   0x00
-#define TIMER_COMPARE_REG 0x04
-#define TIMER_CONTROL_REG 0x08
-
-// ADC register offsets
-#define ADC_DATA_REG      0x00
-#define ADC_CONTROL_REG   0x04
-#define ADC_STATUS_REG    0x08
-
-// Platform-specific implementations
-#ifdef __riscv
-    // RISC-V FPGA implementation
-    #define REG_WRITE(addr, val) (*(volatile uint32_t*)(addr) = (val))
-    #define REG_READ(addr) (*(volatile uint32_t*)(addr))
-#else
-    // Native simulation implementation
-    static uint32_t sim_registers[1024] = {0};
-    #define REG_WRITE(addr, val) (sim_registers[((addr) - FPGA_BASE_ADDR) >> 2] = (val))
-    #define REG_READ(addr) (sim_registers[((addr) - FPGA_BASE_ADDR) >> 2])
-#endif
+#include "fpga_hal_regs.h"
+#include "hal_backend.h"
+#include "hal_log.h"
+
+// Register access goes through the backend selected at build time
+#define REG_WRITE(addr, val) hal_reg_write((addr), (val))
+#define REG_READ(addr) hal_reg_read(addr)
+
+// Pin-level messages are DEBUG, so the default runtime level keeps hot paths quiet
+uint32_t hal_log_runtime_level = HAL_LOG_LEVEL_INFO;
+
+void hal_log_set_level(uint32_t level) {
+    hal_log_runtime_level = level;
+}
+
+uint32_t hal_log_get_level(void) {
+    return hal_log_runtime_level;
+}
 
 // GPIO HAL functions
 void hal_gpio_init(void) {
+    hal_backend_auto_select();
+
     uint32_t gpio_base = FPGA_BASE_ADDR + GPIO_BASE_OFFSET;
     REG_WRITE(gpio_base + GPIO_DIR_REG, 0x00000000);  // All inputs initially
     REG_WRITE(gpio_base + GPIO_DATA_REG, 0x00000000); // All low initially
-    printf("GPIO HAL initialized\n");
+    HAL_LOG_INFO("GPIO HAL initialized\n");
 }
 
 void hal_gpio_set_direction(uint32_t pin, gpio_direction_t direction) {
@@ -61,23 +41,29 @@ void hal_gpio_set_direction(uint32_t pin, gpio_direction_t direction) {
     }
     
     REG_WRITE(gpio_base + GPIO_DIR_REG, dir_reg);
-    printf("GPIO pin %d set as %s\n", pin, (direction == GPIO_OUTPUT) ? "OUTPUT" : "INPUT");
+    HAL_LOG_DEBUG("GPIO pin %d set as %s\n", pin, (direction == GPIO_OUTPUT) ? "OUTPUT" : "INPUT");
 }
 
 void hal_gpio_write(uint32_t pin, uint32_t value) {
     if (pin >= 32) return;
     
     uint32_t gpio_base = FPGA_BASE_ADDR + GPIO_BASE_OFFSET;
+    
+#if FPGA_GPIO_HAS_SET_CLEAR
+    // Single write to the set/clear alias instead of a read-modify-write
+    REG_WRITE(gpio_base + (value ? GPIO_SET_REG : GPIO_CLEAR_REG), 1u << pin);
+#else
     uint32_t data_reg = REG_READ(gpio_base + GPIO_DATA_REG);
     
     if (value) {
-        data_reg |= (1 << pin);
+        data_reg |= (1u << pin);
     } else {
-        data_reg &= ~(1 << pin);
+        data_reg &= ~(1u << pin);
     }
     
     REG_WRITE(gpio_base + GPIO_DATA_REG, data_reg);
-    printf("GPIO pin %d set to %s\n", pin, value ? "HIGH" : "LOW");
+#endif
+    HAL_LOG_DEBUG("GPIO pin %d set to %s\n", pin, value ? "HIGH" : "LOW");
 }
 
 uint32_t hal_gpio_read(uint32_t pin) {
@@ -89,22 +75,125 @@ uint32_t hal_gpio_read(uint32_t pin) {
     return (data_reg >> pin) & 1;
 }
 
+// GPIO port-wide HAL functions
+void hal_gpio_set_direction_mask(uint32_t pin_mask, gpio_direction_t direction) {
+    uint32_t gpio_base = FPGA_BASE_ADDR + GPIO_BASE_OFFSET;
+    uint32_t dir_reg = REG_READ(gpio_base + GPIO_DIR_REG);
+    
+    if (direction == GPIO_OUTPUT) {
+        dir_reg |= pin_mask;
+    } else {
+        dir_reg &= ~pin_mask;
+    }
+    
+    REG_WRITE(gpio_base + GPIO_DIR_REG, dir_reg);
+}
+
+void hal_gpio_write_port(uint32_t value) {
+    uint32_t gpio_base = FPGA_BASE_ADDR + GPIO_BASE_OFFSET;
+    REG_WRITE(gpio_base + GPIO_DATA_REG, value);
+}
+
+uint32_t hal_gpio_read_port(void) {
+    uint32_t gpio_base = FPGA_BASE_ADDR + GPIO_BASE_OFFSET;
+    return REG_READ(gpio_base + GPIO_DATA_REG);
+}
+
+#if FPGA_GPIO_HAS_SET_CLEAR
+void hal_gpio_set_mask(uint32_t pin_mask) {
+    uint32_t gpio_base = FPGA_BASE_ADDR + GPIO_BASE_OFFSET;
+    REG_WRITE(gpio_base + GPIO_SET_REG, pin_mask);
+}
+
+void hal_gpio_clear_mask(uint32_t pin_mask) {
+    uint32_t gpio_base = FPGA_BASE_ADDR + GPIO_BASE_OFFSET;
+    REG_WRITE(gpio_base + GPIO_CLEAR_REG, pin_mask);
+}
+
+void hal_gpio_toggle_mask(uint32_t pin_mask) {
+    uint32_t gpio_base = FPGA_BASE_ADDR + GPIO_BASE_OFFSET;
+    REG_WRITE(gpio_base + GPIO_TOGGLE_REG, pin_mask);
+}
+#else
+// No aliases in the RTL: read-modify-write the data register
+void hal_gpio_set_mask(uint32_t pin_mask) {
+    uint32_t gpio_base = FPGA_BASE_ADDR + GPIO_BASE_OFFSET;
+    REG_WRITE(gpio_base + GPIO_DATA_REG, REG_READ(gpio_base + GPIO_DATA_REG) | pin_mask);
+}
+
+void hal_gpio_clear_mask(uint32_t pin_mask) {
+    uint32_t gpio_base = FPGA_BASE_ADDR + GPIO_BASE_OFFSET;
+    REG_WRITE(gpio_base + GPIO_DATA_REG, REG_READ(gpio_base + GPIO_DATA_REG) & ~pin_mask);
+}
+
+void hal_gpio_toggle_mask(uint32_t pin_mask) {
+    uint32_t gpio_base = FPGA_BASE_ADDR + GPIO_BASE_OFFSET;
+    REG_WRITE(gpio_base + GPIO_DATA_REG, REG_READ(gpio_base + GPIO_DATA_REG) ^ pin_mask);
+}
+#endif
+
+// Drive the pins in pin_mask to the matching bits of value, leaving the rest
+// untouched. With the bit set/reset registers there is no read-back, no race
+// with other writers on unrelated pins, and the pins of each 16-pin half
+// change in one write; only a mask spanning both halves takes two. Without
+// them it is a read-modify-write of the data register, still one data write.
+void hal_gpio_modify(uint32_t pin_mask, uint32_t value) {
+    uint32_t gpio_base = FPGA_BASE_ADDR + GPIO_BASE_OFFSET;
+    
+    if (pin_mask == 0xFFFFFFFFu) {
+        REG_WRITE(gpio_base + GPIO_DATA_REG, value);
+        return;
+    }
+    
+#if FPGA_GPIO_HAS_SET_CLEAR
+    uint32_t set_bits = value & pin_mask;
+    uint32_t clear_bits = ~value & pin_mask;
+    
+    if (pin_mask & 0xFFFFu) {
+        REG_WRITE(gpio_base + GPIO_BSRR_LO_REG,
+                  GPIO_BSRR_SET(set_bits) | GPIO_BSRR_RESET(clear_bits));
+    }
+    if (pin_mask >> GPIO_BSRR_PINS) {
+        REG_WRITE(gpio_base + GPIO_BSRR_HI_REG,
+                  GPIO_BSRR_SET(set_bits >> GPIO_BSRR_PINS) |
+                  GPIO_BSRR_RESET(clear_bits >> GPIO_BSRR_PINS));
+    }
+#else
+    uint32_t data_reg = REG_READ(gpio_base + GPIO_DATA_REG);
+    REG_WRITE(gpio_base + GPIO_DATA_REG, (data_reg & ~pin_mask) | (value & pin_mask));
+#endif
+}
+
 // UART HAL functions
 void hal_uart_init(uint32_t baudrate) {
+    hal_backend_auto_select();
+
     uint32_t uart_base = FPGA_BASE_ADDR + UART_BASE_OFFSET;
     
     // Configure UART (simplified)
-    REG_WRITE(uart_base + UART_CONTROL_REG, 0x00000001); // Enable UART
-    printf("UART HAL initialized at %d baud\n", baudrate);
+    REG_WRITE(uart_base + UART_BAUD_REG, baudrate);
+    REG_WRITE(uart_base + UART_CONTROL_REG, UART_CONTROL_ENABLE);
+    HAL_LOG_INFO("UART HAL initialized at %d baud\n", baudrate);
 }
 
 void hal_uart_send_char(char c) {
     uint32_t uart_base = FPGA_BASE_ADDR + UART_BASE_OFFSET;
     
     // Wait for transmit ready (simplified)
-    while (!(REG_READ(uart_base + UART_STATUS_REG) & 0x01));
+    while (!(REG_READ(uart_base + UART_STATUS_REG) & UART_STATUS_TX_READY));
+    
+    REG_WRITE(uart_base + UART_DATA_REG, (uint8_t)c);
+}
+
+int hal_uart_receive_char(char* c) {
+    uint32_t uart_base = FPGA_BASE_ADDR + UART_BASE_OFFSET;
+    
+    if (!(REG_READ(uart_base + UART_STATUS_REG) & UART_STATUS_RX_VALID)) {
+        return 0;
+    }
     
-    REG_WRITE(uart_base + UART_DATA_REG, c);
+    *c = (char)REG_READ(uart_base + UART_DATA_REG);
+    return 1;
 }
 
 void hal_uart_send_string(const char* str) {
@@ -115,11 +204,14 @@ void hal_uart_send_string(const char* str) {
 
 // Timer HAL functions
 void hal_timer_init(void) {
+    hal_backend_auto_select();
+
     uint32_t timer_base = FPGA_BASE_ADDR + TIMER_BASE_OFFSET;
     
     REG_WRITE(timer_base + TIMER_COUNT_REG, 0);
-    REG_WRITE(timer_base + TIMER_CONTROL_REG, 0x00000001); // Enable timer
-    printf("Timer HAL initialized\n");
+    REG_WRITE(timer_base + TIMER_CONTROL_REG, TIMER_CONTROL_ENABLE);
+    hal_timebase_reset();
+    HAL_LOG_INFO("Timer HAL initialized\n");
 }
 
 uint32_t hal_timer_get_count(void) {
@@ -134,47 +226,35 @@ void hal_timer_set_compare(uint32_t value) {
 
 // ADC HAL functions
 void hal_adc_init(void) {
+    hal_backend_auto_select();
+
     uint32_t adc_base = FPGA_BASE_ADDR + ADC_BASE_OFFSET;
     
-    REG_WRITE(adc_base + ADC_CONTROL_REG, 0x00000001); // Enable ADC
-    printf("ADC HAL initialized\n");
+    REG_WRITE(adc_base + ADC_CONTROL_REG, ADC_CONTROL_ENABLE);
+    HAL_LOG_INFO("ADC HAL initialized\n");
 }
 
 uint16_t hal_adc_read_channel(uint32_t channel) {
-    if (channel >= 8) return 0;
+    if (channel >= ADC_CHANNEL_COUNT) return 0;
     
     uint32_t adc_base = FPGA_BASE_ADDR + ADC_BASE_OFFSET;
     
     // Start conversion
-    REG_WRITE(adc_base + ADC_CONTROL_REG, 0x00000001 | (channel << 4));
+    REG_WRITE(adc_base + ADC_CONTROL_REG, ADC_CONTROL_ENABLE | ADC_CONTROL_START |
+                                          (channel << ADC_CONTROL_CHANNEL_SHIFT));
     
     // Wait for conversion complete
-    while (!(REG_READ(adc_base + ADC_STATUS_REG) & 0x01));
+    while (!(REG_READ(adc_base + ADC_STATUS_REG) & ADC_STATUS_DONE));
     
     return (uint16_t)REG_READ(adc_base + ADC_DATA_REG);
 }
 
 // System HAL functions
 void hal_system_init(void) {
-    printf("Initializing FPGA HAL...\n");
+    HAL_LOG_INFO("Initializing FPGA HAL...\n");
     hal_gpio_init();
     hal_uart_init(115200);
     hal_timer_init();
     hal_adc_init();
-    printf("FPGA HAL initialization complete\n");
+    HAL_LOG_INFO("FPGA HAL initialization complete\n");
 }
-
-void hal_delay_ms(uint32_t ms) {
-#ifdef __riscv
-    // RISC-V implementation using timer
-    uint32_t start_count = hal_timer_get_count();
-    uint32_t target_count = start_count + (ms * 1000); // Assuming 1MHz timer
-    while (hal_timer_get_count() < target_count);
-#else
-    // Native simulation - simple loop
-    volatile uint32_t i;
-    for (uint32_t j = 0; j < ms; j++) {
-        for (i = 0; i < 1000; i++);
-    }
-#endif
-}
\ No newline at end of file
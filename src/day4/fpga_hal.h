@@ -3,6 +3,14 @@
 
 #include <stdint.h>
 
+// HAL log levels. HAL_LOG_LEVEL (compile time) sets the ceiling; the
+// runtime level filters further in builds that keep the messages.
+#define HAL_LOG_LEVEL_NONE  0
+#define HAL_LOG_LEVEL_ERROR 1
+#define HAL_LOG_LEVEL_WARN  2
+#define HAL_LOG_LEVEL_INFO  3
+#define HAL_LOG_LEVEL_DEBUG 4
+
 // GPIO direction enumeration
 typedef enum {
     GPIO_INPUT = 0,
@@ -15,22 +23,137 @@ void hal_gpio_set_direction(uint32_t pin, gpio_direction_t direction);
 void hal_gpio_write(uint32_t pin, uint32_t value);
 uint32_t hal_gpio_read(uint32_t pin);
 
+// GPIO port-wide HAL functions (one bus access per call, no read-modify-write)
+void hal_gpio_set_direction_mask(uint32_t pin_mask, gpio_direction_t direction);
+void hal_gpio_write_port(uint32_t value);
+uint32_t hal_gpio_read_port(void);
+void hal_gpio_set_mask(uint32_t pin_mask);
+void hal_gpio_clear_mask(uint32_t pin_mask);
+void hal_gpio_toggle_mask(uint32_t pin_mask);
+void hal_gpio_modify(uint32_t pin_mask, uint32_t value);
+
 // UART HAL functions
 void hal_uart_init(uint32_t baudrate);
 void hal_uart_send_char(char c);
 void hal_uart_send_string(const char* str);
+int hal_uart_receive_char(char* c);  // Non-blocking, returns 1 if a byte was read
+
+// Buffered UART transmit. hal_uart_write() queues and returns immediately;
+// hal_uart_tx_drain() bursts queued bytes into the hardware FIFO from a poll
+// loop or the TX-ready interrupt. Don't mix with hal_uart_send_char() while
+// bytes are pending, or output will interleave.
+#define HAL_UART_TX_BUFFER_SIZE 4096  // Power of two
+
+typedef struct {
+    uint32_t bytes_queued;
+    uint32_t bytes_dropped;   // Did not fit in the buffer
+    uint32_t bytes_drained;   // Handed to the hardware FIFO
+} hal_uart_tx_stats_t;
+
+uint32_t hal_uart_write(const void* data, uint32_t length);  // Returns bytes queued
+uint32_t hal_uart_tx_drain(void);
+uint32_t hal_uart_tx_pending(void);
+int hal_uart_flush(uint32_t timeout_ms);  // 0 when sent, -1 on timeout
+void hal_uart_tx_get_stats(hal_uart_tx_stats_t* stats);
 
 // Timer HAL functions
 void hal_timer_init(void);
 uint32_t hal_timer_get_count(void);
 void hal_timer_set_compare(uint32_t value);
 
+// Timebase HAL functions. The 64-bit count extends the 32-bit hardware
+// counter in software, so it must be read at least once per counter wrap
+// (about 71 minutes at 1 MHz); every delay and deadline check does so.
+typedef struct {
+    uint64_t expiry;    // Absolute timer tick
+} hal_deadline_t;
+
+uint64_t hal_timer_get_count64(void);
+void hal_timebase_reset(void);  // Call after rewriting TIMER_COUNT directly
+void hal_delay_us(uint32_t us);
+void hal_deadline_set_us(hal_deadline_t* deadline, uint64_t us);
+void hal_deadline_set_ms(hal_deadline_t* deadline, uint64_t ms);
+int hal_deadline_expired(const hal_deadline_t* deadline);
+uint64_t hal_deadline_remaining_us(const hal_deadline_t* deadline);
+void hal_deadline_wait(const hal_deadline_t* deadline);
+
+// Frequency counter: the GPIO edge counter gated by the timer.
+// HAL_FREQ_GATE counts edges over each gate (+-1 edge per gate, good for
+// fast clocks). HAL_FREQ_RECIPROCAL times whole input periods against the
+// timer (+-1 tick per gate, good for slow clocks below ~1 MHz). Results are
+// averaged over gate_count back-to-back gates.
+typedef enum {
+    HAL_FREQ_GATE = 0,
+    HAL_FREQ_RECIPROCAL = 1
+} hal_freq_mode_t;
+
+typedef struct {
+    uint64_t hz;                // Rounded to the nearest hertz
+    uint64_t millihertz;
+    uint64_t min_millihertz;    // Spread of the individual gates
+    uint64_t max_millihertz;
+    uint64_t edges;             // Edges (gate) or whole periods (reciprocal) counted
+    uint64_t ticks;             // Timer ticks they span
+    uint32_t gates;
+} hal_freq_result_t;
+
+void hal_freq_init(uint32_t pin);
+int hal_freq_measure(hal_freq_mode_t mode, uint32_t gate_us, uint32_t gate_count,
+                     hal_freq_result_t* result);  // 0 on success, -1 if no signal
+
 // ADC HAL functions
 void hal_adc_init(void);
 uint16_t hal_adc_read_channel(uint32_t channel);
 
+// ADC scan sequencer (non-blocking). The buffer holds samples_per_channel
+// results for each channel in channel_mask, one array per channel in
+// ascending channel order; hal_adc_scan_samples() returns a channel's array.
+typedef void (*hal_adc_scan_callback_t)(const uint16_t* buffer, uint32_t channel_mask,
+                                        uint32_t samples_per_channel, void* context);
+
+void hal_adc_scan_set_callback(hal_adc_scan_callback_t callback, void* context);
+int hal_adc_scan_start(uint32_t channel_mask, uint32_t samples_per_channel, uint16_t* buffer);
+int hal_adc_scan_poll(void);   // Returns 1 once the scan is complete
+void hal_adc_scan_wait(void);
+int hal_adc_scan_busy(void);
+const uint16_t* hal_adc_scan_samples(uint32_t channel);
+
+// Continuous ADC streaming into a ring of 2..HAL_ADC_STREAM_MAX_BLOCKS
+// blocks (double/triple buffering). storage must hold
+// block_count * frames_per_block * <channels in mask> samples. A block holds
+// frame_count frames, each one sample per enabled channel in ascending order.
+#define HAL_ADC_STREAM_MAX_BLOCKS 8
+
+typedef struct {
+    uint32_t channel_mask;
+    uint32_t frames_per_block;
+    uint32_t block_count;
+    uint16_t* storage;
+} hal_adc_stream_config_t;
+
+typedef struct {
+    uint16_t* samples;
+    uint32_t frame_count;
+    uint32_t channel_count;
+    uint32_t channel_mask;
+    uint32_t sequence;       // Block number since start
+    uint64_t first_sample;   // Index of samples[0] in the converted stream
+} hal_adc_block_t;
+
+int hal_adc_stream_start(const hal_adc_stream_config_t* config);
+void hal_adc_stream_stop(void);
+uint32_t hal_adc_stream_service(void);  // Producer: poll loop or ADC interrupt
+const hal_adc_block_t* hal_adc_stream_acquire(void);  // Consumer: NULL if none ready
+void hal_adc_stream_release(const hal_adc_block_t* block);
+uint32_t hal_adc_stream_overruns(void);
+uint32_t hal_adc_stream_dropped_samples(void);
+
 // System HAL functions
 void hal_system_init(void);
 void hal_delay_ms(uint32_t ms);
 
+// Logging HAL functions
+void hal_log_set_level(uint32_t level);
+uint32_t hal_log_get_level(void);
+
 #endif // FPGA_HAL_H
\ No newline at end of file
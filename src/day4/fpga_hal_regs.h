@@ -0,0 +1,76 @@
+#ifndef FPGA_HAL_REGS_H
+#define FPGA_HAL_REGS_H
+
+// Hardware register base addresses
+#define FPGA_BASE_ADDR    0x40000000
+#define GPIO_BASE_OFFSET  0x00000000
+#define UART_BASE_OFFSET  0x00001000
+#define TIMER_BASE_OFFSET 0x00002000
+#define ADC_BASE_OFFSET   0x00003000
+
+// Size of the register window covering all peripheral blocks
+#define FPGA_WINDOW_SIZE  0x00004000
+#define FPGA_WINDOW_WORDS (FPGA_WINDOW_SIZE / 4)
+
+// GPIO register offsets
+#define GPIO_DATA_REG     0x00
+#define GPIO_DIR_REG      0x04
+#define GPIO_INT_REG      0x08
+// Set/clear/toggle and BSRR exist only where FPGA_GPIO_HAS_SET_CLEAR is set
+#define GPIO_SET_REG      0x0C  // Write-1-to-set alias of GPIO_DATA_REG
+#define GPIO_CLEAR_REG    0x10  // Write-1-to-clear alias of GPIO_DATA_REG
+#define GPIO_TOGGLE_REG   0x14  // Write-1-to-toggle alias of GPIO_DATA_REG
+#define GPIO_EDGE_CONTROL_REG 0x18  // Edge counter input select and enable
+#define GPIO_EDGE_COUNT_REG   0x1C  // Rising edges since enable; a read latches EDGE_TIME
+#define GPIO_EDGE_TIME_REG    0x20  // TIMER_COUNT at the last edge in the latched count
+#define GPIO_BSRR_LO_REG      0x24  // Set/reset pins 0-15 in one write, see below
+#define GPIO_BSRR_HI_REG      0x28  // Set/reset pins 16-31 in one write
+
+// GPIO edge counter bits
+#define GPIO_EDGE_PIN_MASK    0x1Fu
+#define GPIO_EDGE_ENABLE      (1u << 8)  // Writing the register restarts the count
+
+// GPIO bit set/reset registers: bits 15:0 set the half's pins, bits 31:16
+// clear them, and both take effect together (set wins if a pin has both).
+// A pattern on pins of one half is a single write with no intermediate state.
+#define GPIO_BSRR_PINS        16u
+#define GPIO_BSRR_SET(pins)   ((pins) & 0xFFFFu)
+#define GPIO_BSRR_RESET(pins) (((pins) & 0xFFFFu) << 16)
+
+// UART register offsets
+#define UART_DATA_REG     0x00
+#define UART_STATUS_REG   0x04
+#define UART_CONTROL_REG  0x08
+#define UART_BAUD_REG     0x0C
+
+// UART register bits
+#define UART_STATUS_TX_READY  (1u << 0)  // Transmit holding register free
+#define UART_STATUS_RX_VALID  (1u << 1)  // Received byte waiting in UART_DATA_REG
+#define UART_STATUS_TX_EMPTY  (1u << 2)  // TX FIFO and shifter both idle
+#define UART_CONTROL_ENABLE   (1u << 0)
+#define UART_TX_FIFO_DEPTH    16         // TX_READY stays set until the FIFO is full
+
+// Timer register offsets
+#define TIMER_COUNT_REG   0x00
+#define TIMER_COMPARE_REG 0x04
+#define TIMER_CONTROL_REG 0x08
+#define TIMER_STATUS_REG  0x0C
+
+// Timer register bits
+#define TIMER_CONTROL_ENABLE  (1u << 0)
+#define TIMER_STATUS_MATCH    (1u << 0)  // Count reached compare, write 1 to clear
+#define TIMER_FREQUENCY_HZ    1000000u
+
+// ADC register offsets
+#define ADC_DATA_REG      0x00
+#define ADC_CONTROL_REG   0x04
+#define ADC_STATUS_REG    0x08
+
+// ADC register bits
+#define ADC_CONTROL_ENABLE    (1u << 0)
+#define ADC_CONTROL_START     (1u << 1)  // Start a conversion on the selected channel
+#define ADC_CONTROL_CHANNEL_SHIFT 4
+#define ADC_STATUS_DONE       (1u << 0)  // Conversion result valid in ADC_DATA_REG
+#define ADC_CHANNEL_COUNT     8
+
+#endif // FPGA_HAL_REGS_H
@@ -0,0 +1,129 @@
+#include "fpga_hal.h"
+#include "fpga_hal_regs.h"
+#include "hal_backend.h"
+
+// Non-blocking multi-channel ADC scan sequencer. One scan converts every
+// channel in the mask in ascending order, then repeats the sweep until each
+// channel has samples_per_channel results. The next conversion is started as
+// soon as a result is read, so the converter never idles while the caller
+// does other work between polls.
+//
+// Buffer layout: one contiguous array per enabled channel, in ascending
+// channel order (see hal_adc_scan_samples()).
+
+#define REG_WRITE(addr, val) hal_reg_write((addr), (val))
+#define REG_READ(addr) hal_reg_read(addr)
+
+typedef struct {
+    uint32_t channel_mask;
+    uint32_t samples_per_channel;
+    uint16_t* buffer;
+    uint32_t slot[ADC_CHANNEL_COUNT];  // Index of each channel's array in buffer
+    uint32_t channel_count;
+    uint32_t current_channel;
+    uint32_t sample_index;
+    uint32_t samples_done;
+    int busy;
+    hal_adc_scan_callback_t callback;
+    void* callback_context;
+} adc_scan_t;
+
+static adc_scan_t adc_scan;
+
+static void adc_scan_convert(uint32_t channel) {
+    uint32_t adc_base = FPGA_BASE_ADDR + ADC_BASE_OFFSET;
+    REG_WRITE(adc_base + ADC_CONTROL_REG, ADC_CONTROL_ENABLE | ADC_CONTROL_START |
+                                          (channel << ADC_CONTROL_CHANNEL_SHIFT));
+}
+
+static uint32_t adc_scan_next_channel(uint32_t channel) {
+    for (uint32_t i = 1; i <= ADC_CHANNEL_COUNT; i++) {
+        uint32_t candidate = (channel + i) % ADC_CHANNEL_COUNT;
+        if (adc_scan.channel_mask & (1u << candidate)) {
+            return candidate;
+        }
+    }
+    return channel;
+}
+
+void hal_adc_scan_set_callback(hal_adc_scan_callback_t callback, void* context) {
+    adc_scan.callback = callback;
+    adc_scan.callback_context = context;
+}
+
+int hal_adc_scan_start(uint32_t channel_mask, uint32_t samples_per_channel, uint16_t* buffer) {
+    channel_mask &= (1u << ADC_CHANNEL_COUNT) - 1;
+    if (adc_scan.busy || channel_mask == 0 || samples_per_channel == 0 || !buffer) {
+        return -1;
+    }
+    
+    adc_scan.channel_mask = channel_mask;
+    adc_scan.samples_per_channel = samples_per_channel;
+    adc_scan.buffer = buffer;
+    adc_scan.channel_count = 0;
+    for (uint32_t channel = 0; channel < ADC_CHANNEL_COUNT; channel++) {
+        if (channel_mask & (1u << channel)) {
+            adc_scan.slot[channel] = adc_scan.channel_count++;
+        }
+    }
+    
+    adc_scan.current_channel = adc_scan_next_channel(ADC_CHANNEL_COUNT - 1);
+    adc_scan.sample_index = 0;
+    adc_scan.samples_done = 0;
+    adc_scan.busy = 1;
+    
+    adc_scan_convert(adc_scan.current_channel);
+    return 0;
+}
+
+int hal_adc_scan_poll(void) {
+    if (!adc_scan.busy) return 1;
+    
+    uint32_t adc_base = FPGA_BASE_ADDR + ADC_BASE_OFFSET;
+    if (!(REG_READ(adc_base + ADC_STATUS_REG) & ADC_STATUS_DONE)) {
+        return 0;
+    }
+    
+    uint16_t sample = (uint16_t)REG_READ(adc_base + ADC_DATA_REG);
+    uint32_t channel = adc_scan.current_channel;
+    uint32_t total = adc_scan.channel_count * adc_scan.samples_per_channel;
+    
+    adc_scan.buffer[adc_scan.slot[channel] * adc_scan.samples_per_channel +
+                    adc_scan.sample_index] = sample;
+    adc_scan.samples_done++;
+    
+    if (adc_scan.samples_done < total) {
+        // Keep the converter busy before doing any bookkeeping
+        uint32_t next = adc_scan_next_channel(channel);
+        adc_scan_convert(next);
+        if (next <= channel) {
+            adc_scan.sample_index++;  // Wrapped around: next sweep
+        }
+        adc_scan.current_channel = next;
+        return 0;
+    }
+    
+    adc_scan.busy = 0;
+    if (adc_scan.callback) {
+        adc_scan.callback(adc_scan.buffer, adc_scan.channel_mask,
+                          adc_scan.samples_per_channel, adc_scan.callback_context);
+    }
+    return 1;
+}
+
+void hal_adc_scan_wait(void) {
+    while (!hal_adc_scan_poll());
+}
+
+int hal_adc_scan_busy(void) {
+    return adc_scan.busy;
+}
+
+const uint16_t* hal_adc_scan_samples(uint32_t channel) {
+    if (channel >= ADC_CHANNEL_COUNT || !(adc_scan.channel_mask & (1u << channel)) ||
+        !adc_scan.buffer) {
+        return NULL;
+    }
+    
+    return &adc_scan.buffer[adc_scan.slot[channel] * adc_scan.samples_per_channel];
+}
@@ -0,0 +1,157 @@
+#include "fpga_hal.h"
+#include "fpga_hal_regs.h"
+#include "hal_backend.h"
+
+// Continuous ADC acquisition into a ring of sample blocks.
+//
+// The producer side (hal_adc_stream_service(), called from a poll loop or
+// the ADC interrupt) fills one block at a time and publishes it; the
+// consumer borrows whole published blocks with hal_adc_stream_acquire() and
+// hands them back with hal_adc_stream_release(). Head and tail are
+// free-running counters with acquire/release ordering, so one producer and
+// one consumer need no lock. When every block is still held by the consumer
+// the producer drops samples and counts an overrun.
+
+#define REG_WRITE(addr, val) hal_reg_write((addr), (val))
+#define REG_READ(addr) hal_reg_read(addr)
+
+typedef struct {
+    hal_adc_block_t blocks[HAL_ADC_STREAM_MAX_BLOCKS];
+    uint32_t block_count;
+    uint32_t frames_per_block;
+    uint32_t channel_mask;
+    uint32_t channel_count;
+    
+    uint32_t head;              // Blocks published (producer)
+    uint32_t tail;              // Blocks released (consumer)
+    
+    // Producer state
+    uint32_t fill_index;        // Samples written into the current block
+    uint32_t current_channel;
+    uint64_t sample_index;      // Samples converted since start, dropped ones included
+    uint32_t overruns;
+    uint32_t dropped_samples;
+    int in_overrun;
+    int running;
+} adc_stream_t;
+
+static adc_stream_t adc_stream;
+
+static void adc_stream_convert(uint32_t channel) {
+    uint32_t adc_base = FPGA_BASE_ADDR + ADC_BASE_OFFSET;
+    REG_WRITE(adc_base + ADC_CONTROL_REG, ADC_CONTROL_ENABLE | ADC_CONTROL_START |
+                                          (channel << ADC_CONTROL_CHANNEL_SHIFT));
+}
+
+static uint32_t adc_stream_next_channel(uint32_t channel) {
+    for (uint32_t i = 1; i <= ADC_CHANNEL_COUNT; i++) {
+        uint32_t candidate = (channel + i) % ADC_CHANNEL_COUNT;
+        if (adc_stream.channel_mask & (1u << candidate)) {
+            return candidate;
+        }
+    }
+    return channel;
+}
+
+int hal_adc_stream_start(const hal_adc_stream_config_t* config) {
+    if (!config || !config->storage || adc_stream.running) return -1;
+    
+    uint32_t channel_mask = config->channel_mask & ((1u << ADC_CHANNEL_COUNT) - 1);
+    if (channel_mask == 0 || config->frames_per_block == 0 ||
+        config->block_count < 2 || config->block_count > HAL_ADC_STREAM_MAX_BLOCKS) {
+        return -1;
+    }
+    
+    adc_stream = (adc_stream_t){0};
+    adc_stream.channel_mask = channel_mask;
+    for (uint32_t channel = 0; channel < ADC_CHANNEL_COUNT; channel++) {
+        if (channel_mask & (1u << channel)) adc_stream.channel_count++;
+    }
+    
+    adc_stream.block_count = config->block_count;
+    adc_stream.frames_per_block = config->frames_per_block;
+    uint32_t block_samples = config->frames_per_block * adc_stream.channel_count;
+    for (uint32_t i = 0; i < config->block_count; i++) {
+        hal_adc_block_t* block = &adc_stream.blocks[i];
+        block->samples = config->storage + i * block_samples;
+        block->frame_count = config->frames_per_block;
+        block->channel_count = adc_stream.channel_count;
+        block->channel_mask = channel_mask;
+    }
+    
+    adc_stream.current_channel = adc_stream_next_channel(ADC_CHANNEL_COUNT - 1);
+    adc_stream.running = 1;
+    adc_stream_convert(adc_stream.current_channel);
+    return 0;
+}
+
+void hal_adc_stream_stop(void) {
+    adc_stream.running = 0;
+}
+
+uint32_t hal_adc_stream_service(void) {
+    if (!adc_stream.running) return 0;
+    
+    uint32_t adc_base = FPGA_BASE_ADDR + ADC_BASE_OFFSET;
+    if (!(REG_READ(adc_base + ADC_STATUS_REG) & ADC_STATUS_DONE)) {
+        return 0;
+    }
+    
+    uint16_t sample = (uint16_t)REG_READ(adc_base + ADC_DATA_REG);
+    adc_stream.current_channel = adc_stream_next_channel(adc_stream.current_channel);
+    adc_stream_convert(adc_stream.current_channel);
+    
+    uint64_t sample_index = adc_stream.sample_index++;
+    uint32_t tail = __atomic_load_n(&adc_stream.tail, __ATOMIC_ACQUIRE);
+    
+    // A new block may only be started on a frame boundary with a free slot
+    if (adc_stream.fill_index == 0) {
+        if (adc_stream.head - tail >= adc_stream.block_count ||
+            (sample_index % adc_stream.channel_count) != 0) {
+            if (!adc_stream.in_overrun && adc_stream.head - tail >= adc_stream.block_count) {
+                adc_stream.overruns++;
+                adc_stream.in_overrun = 1;
+            }
+            adc_stream.dropped_samples++;
+            return 1;
+        }
+        
+        adc_stream.in_overrun = 0;
+        hal_adc_block_t* block = &adc_stream.blocks[adc_stream.head % adc_stream.block_count];
+        block->sequence = adc_stream.head;
+        block->first_sample = sample_index;
+    }
+    
+    hal_adc_block_t* block = &adc_stream.blocks[adc_stream.head % adc_stream.block_count];
+    block->samples[adc_stream.fill_index++] = sample;
+    
+    if (adc_stream.fill_index == adc_stream.frames_per_block * adc_stream.channel_count) {
+        adc_stream.fill_index = 0;
+        __atomic_store_n(&adc_stream.head, adc_stream.head + 1, __ATOMIC_RELEASE);
+    }
+    
+    return 1;
+}
+
+const hal_adc_block_t* hal_adc_stream_acquire(void) {
+    uint32_t head = __atomic_load_n(&adc_stream.head, __ATOMIC_ACQUIRE);
+    uint32_t tail = adc_stream.tail;
+    
+    if (head == tail) return NULL;
+    return &adc_stream.blocks[tail % adc_stream.block_count];
+}
+
+void hal_adc_stream_release(const hal_adc_block_t* block) {
+    uint32_t tail = adc_stream.tail;
+    if (!block || block != &adc_stream.blocks[tail % adc_stream.block_count]) return;
+    
+    __atomic_store_n(&adc_stream.tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+uint32_t hal_adc_stream_overruns(void) {
+    return adc_stream.overruns;
+}
+
+uint32_t hal_adc_stream_dropped_samples(void) {
+    return adc_stream.dropped_samples;
+}
@@ -0,0 +1,108 @@
+#include <stdlib.h>
+#include <string.h>
+#include "hal_backend.h"
+
+#ifdef __riscv
+// Direct MMIO backend, for multi-backend builds on target
+static uint32_t mmio_read(uint32_t addr) {
+    return *(volatile uint32_t*)(uintptr_t)addr;
+}
+
+static void mmio_write(uint32_t addr, uint32_t value) {
+    *(volatile uint32_t*)(uintptr_t)addr = value;
+}
+
+const hal_backend_t hal_backend_mmio = {
+    "mmio",
+    NULL,
+    mmio_read,
+    mmio_write
+};
+#endif
+
+#if defined(HAL_BACKEND_MMIO)
+
+int hal_backend_select(const char* name) {
+    return (name && strcmp(name, "mmio") == 0) ? 0 : -1;
+}
+
+const char* hal_backend_name(void) {
+    return "mmio";
+}
+
+void hal_backend_auto_select(void) {
+}
+
+#elif defined(HAL_BACKEND_SIM)
+
+int hal_backend_select(const char* name) {
+    return (name && strcmp(name, "sim") == 0) ? 0 : -1;
+}
+
+const char* hal_backend_name(void) {
+    return "sim";
+}
+
+void hal_backend_auto_select(void) {
+}
+
+#else
+
+// Backends compiled into a multi-backend build
+static const hal_backend_t* const hal_backends[] = {
+#ifdef __riscv
+    &hal_backend_mmio,
+#endif
+    &hal_backend_sim,
+    &hal_backend_record,
+#if HAL_HAVE_MAPPED_BACKEND
+    &hal_backend_mapped,
+    &hal_backend_shm,
+#endif
+    NULL
+};
+
+#ifdef __riscv
+const hal_backend_t* hal_backend_active = &hal_backend_mmio;
+#else
+const hal_backend_t* hal_backend_active = &hal_backend_sim;
+#endif
+
+static int backend_auto_selected = 0;
+
+int hal_backend_select(const char* name) {
+    if (!name) return -1;
+    
+    for (int i = 0; hal_backends[i]; i++) {
+        const hal_backend_t* backend = hal_backends[i];
+        if (strcmp(backend->name, name) != 0) continue;
+        
+        if (backend->open && backend->open() != 0) {
+            return -1;
+        }
+        
+        hal_backend_active = backend;
+        backend_auto_selected = 1;
+        return 0;
+    }
+    
+    return -1;
+}
+
+const char* hal_backend_name(void) {
+    return hal_backend_active->name;
+}
+
+// Honour FPGA_HAL_BACKEND once, before the first peripheral is initialised
+void hal_backend_auto_select(void) {
+    if (backend_auto_selected) return;
+    backend_auto_selected = 1;
+    
+    const char* name = getenv("FPGA_HAL_BACKEND");
+    if (name && hal_backend_select(name) != 0) {
+        fprintf(stderr, "Unknown or unavailable HAL backend '%s', using %s\n",
+                name, hal_backend_active->name);
+    }
+}
+
+#endif
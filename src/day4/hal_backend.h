@@ -0,0 +1,136 @@
+#ifndef HAL_BACKEND_H
+#define HAL_BACKEND_H
+
+#include <stdio.h>
+#include <stdint.h>
+
+// Register access backend selection. Exactly one of these is defined by the
+// build (CMake option FPGA_HAL_BACKEND):
+//   HAL_BACKEND_MMIO  - raw volatile loads/stores, fully inlined
+//   HAL_BACKEND_SIM   - direct calls into the in-process simulator
+//   HAL_BACKEND_MULTI - one indirect call through the active backend table
+#if !defined(HAL_BACKEND_MMIO) && !defined(HAL_BACKEND_SIM) && !defined(HAL_BACKEND_MULTI)
+    #ifdef __riscv
+        #define HAL_BACKEND_MMIO
+    #else
+        #define HAL_BACKEND_MULTI
+    #endif
+#endif
+
+// GPIO set/clear/toggle aliases and bit set/reset registers (GPIO_SET_REG
+// .. GPIO_BSRR_HI_REG). The simulator models them; the FPGA RTL has only
+// DATA, DIR and INT, so MMIO builds read-modify-write GPIO_DATA_REG instead.
+// Define to 1 when building for a bitstream that adds them.
+#ifndef FPGA_GPIO_HAS_SET_CLEAR
+    #if defined(HAL_BACKEND_SIM) || defined(HAL_BACKEND_MULTI)
+        #define FPGA_GPIO_HAS_SET_CLEAR 1
+    #else
+        #define FPGA_GPIO_HAS_SET_CLEAR 0
+    #endif
+#endif
+
+// File mapping needs a POSIX host
+#ifndef __riscv
+    #define HAL_HAVE_MAPPED_BACKEND 1
+#else
+    #define HAL_HAVE_MAPPED_BACKEND 0
+#endif
+
+// Backend interface
+typedef struct {
+    const char* name;
+    int (*open)(void);      // Optional, called when the backend is selected
+    uint32_t (*read)(uint32_t addr);
+    void (*write)(uint32_t addr, uint32_t value);
+} hal_backend_t;
+
+// Available backends
+#ifdef __riscv
+extern const hal_backend_t hal_backend_mmio;
+#endif
+extern const hal_backend_t hal_backend_sim;
+extern const hal_backend_t hal_backend_record;
+#if HAL_HAVE_MAPPED_BACKEND
+extern const hal_backend_t hal_backend_mapped;
+extern const hal_backend_t hal_backend_shm;
+#endif
+
+// In-process simulator (hal_sim.c). The register file defaults to private
+// storage; the mapped backends attach an external window instead. All window
+// accesses are atomic 32-bit operations, so other processes may share it.
+// hal_sim_peek() reads without any simulated side effects (for viewers).
+uint32_t hal_sim_read(uint32_t addr);
+void hal_sim_write(uint32_t addr, uint32_t value);
+uint32_t hal_sim_peek(uint32_t addr);
+void hal_sim_attach(uint32_t* window);
+void hal_sim_reset(void);
+
+// Recording backend: forwards to a target backend and keeps a trace
+typedef struct {
+    uint32_t sequence;
+    uint32_t addr;
+    uint32_t value;
+    uint8_t is_write;
+} hal_record_entry_t;
+
+void hal_record_set_target(const hal_backend_t* target);
+uint32_t hal_record_count(void);
+uint32_t hal_record_dropped(void);
+int hal_record_get(uint32_t index, hal_record_entry_t* entry);
+void hal_record_clear(void);
+void hal_record_dump(FILE* out);
+
+// File or POSIX shared-memory register file (hal_backend_mapped.c). One
+// process drives the peripherals (open, fails while another live process
+// does); any others may only observe the registers.
+#if HAL_HAVE_MAPPED_BACKEND
+int hal_mapped_open(const char* path);
+int hal_shared_open(const char* name);
+int hal_mapped_observe(const char* path);
+int hal_shared_observe(const char* name);
+int hal_shared_unlink(const char* name);
+void hal_mapped_close(void);
+uint32_t hal_mapped_attach_count(void);
+#endif
+
+// Backend selection. Single-backend builds only accept their own backend.
+int hal_backend_select(const char* name);
+const char* hal_backend_name(void);
+void hal_backend_auto_select(void);
+
+// Register access dispatch
+#if defined(HAL_BACKEND_MMIO)
+
+static inline uint32_t hal_reg_read(uint32_t addr) {
+    return *(volatile uint32_t*)(uintptr_t)addr;
+}
+
+static inline void hal_reg_write(uint32_t addr, uint32_t value) {
+    *(volatile uint32_t*)(uintptr_t)addr = value;
+}
+
+#elif defined(HAL_BACKEND_SIM)
+
+static inline uint32_t hal_reg_read(uint32_t addr) {
+    return hal_sim_read(addr);
+}
+
+static inline void hal_reg_write(uint32_t addr, uint32_t value) {
+    hal_sim_write(addr, value);
+}
+
+#else
+
+extern const hal_backend_t* hal_backend_active;
+
+static inline uint32_t hal_reg_read(uint32_t addr) {
+    return hal_backend_active->read(addr);
+}
+
+static inline void hal_reg_write(uint32_t addr, uint32_t value) {
+    hal_backend_active->write(addr, value);
+}
+
+#endif
+
+#endif // HAL_BACKEND_H
@@ -0,0 +1,226 @@
+#define _POSIX_C_SOURCE 200112L
+#include "hal_backend.h"
+
+#if HAL_HAVE_MAPPED_BACKEND
+
+#include <stdlib.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "fpga_hal_regs.h"
+
+// Mapped register files: the simulator runs on top of a register window that
+// lives in a file or a POSIX shared-memory object instead of private memory.
+// Every process that maps the same object sees one simulated board; the
+// simulator uses atomic 32-bit accesses, so no IPC happens per register.
+//
+// Only the window is shared: the event queue and the virtual clock live in
+// the process that drives the peripherals. A second driver would poll status
+// bits that only the first one's events ever set, and hang. So one process
+// per region is the driver (hal_mapped_open, hal_shared_open); any number of
+// others may observe (hal_mapped_observe, hal_shared_observe), as
+// hal_regview does. A driver that exits without closing is detected by pid.
+//
+// Layout: one header page describing the window, then the window itself.
+#define HAL_MAPPED_DEFAULT_PATH "fpga_registers.bin"
+#define HAL_SHARED_DEFAULT_NAME "/fpga_hal_sim"
+
+#define HAL_SHARED_MAGIC       0x46504741u  // "FPGA"
+#define HAL_SHARED_MAGIC_INIT  0xFFFFFFFFu  // Creator is filling in the header
+#define HAL_SHARED_VERSION     1
+#define HAL_SHARED_HEADER_SIZE 4096
+#define HAL_SHARED_REGION_SIZE (HAL_SHARED_HEADER_SIZE + FPGA_WINDOW_SIZE)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t window_base;
+    uint32_t window_size;
+    uint32_t attach_count;
+    uint32_t driver_pid;        // 0 when no process drives the peripherals
+} hal_shared_header_t;
+
+static void* mapped_region = NULL;
+static int mapped_driver = 0;
+
+static hal_shared_header_t* mapped_header(void) {
+    return (hal_shared_header_t*)mapped_region;
+}
+
+// The first process to map a fresh (zero-filled) region claims it and writes
+// the header; later ones wait until the magic is published.
+static int mapped_init_header(hal_shared_header_t* header) {
+    uint32_t expected = 0;
+    if (__atomic_compare_exchange_n(&header->magic, &expected, HAL_SHARED_MAGIC_INIT,
+                                    0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        header->version = HAL_SHARED_VERSION;
+        header->window_base = FPGA_BASE_ADDR;
+        header->window_size = FPGA_WINDOW_SIZE;
+        __atomic_store_n(&header->magic, HAL_SHARED_MAGIC, __ATOMIC_RELEASE);
+    }
+    
+    struct timespec pause = {0, 1000000};
+    for (int tries = 0; tries < 1000; tries++) {
+        if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) == HAL_SHARED_MAGIC) {
+            break;
+        }
+        nanosleep(&pause, NULL);
+    }
+    
+    if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != HAL_SHARED_MAGIC ||
+        header->version != HAL_SHARED_VERSION ||
+        header->window_base != FPGA_BASE_ADDR ||
+        header->window_size != FPGA_WINDOW_SIZE) {
+        fprintf(stderr, "hal_mapped: register file has an incompatible layout\n");
+        return -1;
+    }
+    
+    return 0;
+}
+
+// Claim the region for this process, taking over from a driver that died
+static int mapped_claim_driver(hal_shared_header_t* header, const char* what) {
+    uint32_t self = (uint32_t)getpid();
+    uint32_t owner = __atomic_load_n(&header->driver_pid, __ATOMIC_ACQUIRE);
+    
+    for (;;) {
+        if (owner != 0 && owner != self &&
+            (kill((pid_t)owner, 0) == 0 || errno != ESRCH)) {
+            fprintf(stderr, "%s: process %u already drives this simulated board; "
+                    "only one process may drive it, others can only observe\n",
+                    what, (unsigned)owner);
+            return -1;
+        }
+        if (__atomic_compare_exchange_n(&header->driver_pid, &owner, self, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            return 0;
+        }
+    }
+}
+
+static int mapped_attach_fd(int fd, const char* what, int driver) {
+    if (ftruncate(fd, HAL_SHARED_REGION_SIZE) != 0) {
+        perror(what);
+        close(fd);
+        return -1;
+    }
+    
+    void* region = mmap(NULL, HAL_SHARED_REGION_SIZE, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, fd, 0);
+    close(fd);
+    if (region == MAP_FAILED) {
+        perror(what);
+        return -1;
+    }
+    
+    if (mapped_init_header((hal_shared_header_t*)region) != 0 ||
+        (driver && mapped_claim_driver((hal_shared_header_t*)region, what) != 0)) {
+        munmap(region, HAL_SHARED_REGION_SIZE);
+        return -1;
+    }
+    
+    mapped_region = region;
+    mapped_driver = driver;
+    __atomic_fetch_add(&mapped_header()->attach_count, 1, __ATOMIC_ACQ_REL);
+    
+    // Keep the attach count honest for viewers when a process just exits
+    static int close_registered = 0;
+    if (!close_registered) {
+        atexit(hal_mapped_close);
+        close_registered = 1;
+    }
+    hal_sim_attach((uint32_t*)((char*)region + HAL_SHARED_HEADER_SIZE));
+    return 0;
+}
+
+static int mapped_open_file(const char* path, const char* what, int driver) {
+    if (mapped_region) return 0;
+    
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        perror(what);
+        return -1;
+    }
+    
+    return mapped_attach_fd(fd, what, driver);
+}
+
+static int mapped_open_shared(const char* name, const char* what, int driver) {
+    if (mapped_region) return 0;
+    
+    int fd = shm_open(name, O_RDWR | O_CREAT, 0660);
+    if (fd < 0) {
+        perror(what);
+        return -1;
+    }
+    
+    return mapped_attach_fd(fd, what, driver);
+}
+
+int hal_mapped_open(const char* path) {
+    return mapped_open_file(path, "hal_mapped_open", 1);
+}
+
+int hal_shared_open(const char* name) {
+    return mapped_open_shared(name, "hal_shared_open", 1);
+}
+
+int hal_mapped_observe(const char* path) {
+    return mapped_open_file(path, "hal_mapped_observe", 0);
+}
+
+int hal_shared_observe(const char* name) {
+    return mapped_open_shared(name, "hal_shared_observe", 0);
+}
+
+int hal_shared_unlink(const char* name) {
+    return shm_unlink(name ? name : HAL_SHARED_DEFAULT_NAME);
+}
+
+void hal_mapped_close(void) {
+    if (!mapped_region) return;
+    
+    if (mapped_driver) {
+        __atomic_store_n(&mapped_header()->driver_pid, 0, __ATOMIC_RELEASE);
+        mapped_driver = 0;
+    }
+    __atomic_fetch_sub(&mapped_header()->attach_count, 1, __ATOMIC_ACQ_REL);
+    hal_sim_attach(NULL);
+    munmap(mapped_region, HAL_SHARED_REGION_SIZE);
+    mapped_region = NULL;
+}
+
+uint32_t hal_mapped_attach_count(void) {
+    if (!mapped_region) return 0;
+    
+    return __atomic_load_n(&mapped_header()->attach_count, __ATOMIC_ACQUIRE);
+}
+
+static int mapped_open(void) {
+    const char* path = getenv("FPGA_HAL_MAP_FILE");
+    return hal_mapped_open(path ? path : HAL_MAPPED_DEFAULT_PATH);
+}
+
+static int shared_open(void) {
+    const char* name = getenv("FPGA_HAL_SHM_NAME");
+    return hal_shared_open(name ? name : HAL_SHARED_DEFAULT_NAME);
+}
+
+const hal_backend_t hal_backend_mapped = {
+    "mapped",
+    mapped_open,
+    hal_sim_read,
+    hal_sim_write
+};
+
+const hal_backend_t hal_backend_shm = {
+    "shm",
+    shared_open,
+    hal_sim_read,
+    hal_sim_write
+};
+
+#endif // HAL_HAVE_MAPPED_BACKEND
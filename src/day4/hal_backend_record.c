@@ -0,0 +1,93 @@
+#include "hal_backend.h"
+
+// Recording backend: every access is forwarded to the target backend and
+// appended to a fixed-size trace. Once the trace is full, later accesses are
+// still forwarded but only counted as dropped.
+#define HAL_RECORD_CAPACITY 4096
+
+static hal_record_entry_t record_trace[HAL_RECORD_CAPACITY];
+static uint32_t record_count = 0;
+static uint32_t record_dropped = 0;
+static uint32_t record_sequence = 0;
+
+#ifdef __riscv
+static const hal_backend_t* record_target = &hal_backend_mmio;
+#else
+static const hal_backend_t* record_target = &hal_backend_sim;
+#endif
+
+static void record_append(uint32_t addr, uint32_t value, uint8_t is_write) {
+    uint32_t sequence = record_sequence++;
+    
+    if (record_count >= HAL_RECORD_CAPACITY) {
+        record_dropped++;
+        return;
+    }
+    
+    hal_record_entry_t* entry = &record_trace[record_count++];
+    entry->sequence = sequence;
+    entry->addr = addr;
+    entry->value = value;
+    entry->is_write = is_write;
+}
+
+static uint32_t record_read(uint32_t addr) {
+    uint32_t value = record_target->read(addr);
+    record_append(addr, value, 0);
+    return value;
+}
+
+static void record_write(uint32_t addr, uint32_t value) {
+    record_append(addr, value, 1);
+    record_target->write(addr, value);
+}
+
+static int record_open(void) {
+    return record_target->open ? record_target->open() : 0;
+}
+
+void hal_record_set_target(const hal_backend_t* target) {
+    if (target && target != &hal_backend_record) {
+        record_target = target;
+    }
+}
+
+uint32_t hal_record_count(void) {
+    return record_count;
+}
+
+uint32_t hal_record_dropped(void) {
+    return record_dropped;
+}
+
+int hal_record_get(uint32_t index, hal_record_entry_t* entry) {
+    if (index >= record_count || !entry) return -1;
+    
+    *entry = record_trace[index];
+    return 0;
+}
+
+void hal_record_clear(void) {
+    record_count = 0;
+    record_dropped = 0;
+    record_sequence = 0;
+}
+
+void hal_record_dump(FILE* out) {
+    for (uint32_t i = 0; i < record_count; i++) {
+        const hal_record_entry_t* entry = &record_trace[i];
+        fprintf(out, "%6u %s 0x%08X 0x%08X\n", (unsigned)entry->sequence,
+                entry->is_write ? "W" : "R", (unsigned)entry->addr, (unsigned)entry->value);
+    }
+    
+    if (record_dropped) {
+        fprintf(out, "(%u accesses not recorded, trace full)\n", (unsigned)record_dropped);
+    }
+}
+
+const hal_backend_t hal_backend_record = {
+    "record",
+    record_open,
+    record_read,
+    record_write
+};
@@ -0,0 +1,114 @@
+#include "fpga_hal.h"
+#include "fpga_hal_regs.h"
+#include "hal_backend.h"
+
+// Frequency counter on top of the GPIO edge counter and the 1 MHz timer.
+//
+// Gate mode divides the edges seen during a gate by the timer ticks the gate
+// lasted; the error is +-1 edge per gate, so it suits fast clocks. Reciprocal
+// mode uses the EDGE_TIME capture instead: the span between the last edge
+// before the gate opened and the last edge before it closed is a whole
+// number of input periods, so the error is +-1 timer tick per gate whatever
+// the input frequency - far better for slow clocks (1 ppm over a 1 s gate).
+//
+// The 32-bit edge count is sampled every FREQ_CHUNK_US within a gate and
+// the differences summed into 64 bits, so counts stay exact up to ~40 GHz.
+
+#define REG_WRITE(addr, val) hal_reg_write((addr), (val))
+#define REG_READ(addr) hal_reg_read(addr)
+
+#define FREQ_TICKS_PER_US (TIMER_FREQUENCY_HZ / 1000000u)
+#define FREQ_CHUNK_US 100000u
+#define FREQ_MILLIHERTZ_PER_TICK_RATE (1000ull * TIMER_FREQUENCY_HZ)
+
+typedef struct {
+    uint32_t count;
+    uint32_t stamp;   // Timer count at the last counted edge
+    uint64_t now;     // 64-bit timer count just after the sample
+} freq_sample_t;
+
+static void freq_sample(freq_sample_t* sample) {
+    uint32_t gpio_base = FPGA_BASE_ADDR + GPIO_BASE_OFFSET;
+    sample->count = REG_READ(gpio_base + GPIO_EDGE_COUNT_REG);  // Latches EDGE_TIME
+    sample->stamp = REG_READ(gpio_base + GPIO_EDGE_TIME_REG);
+    sample->now = hal_timer_get_count64();
+}
+
+// floor(a * b / divisor) without a 128-bit intermediate; exact while
+// (a % divisor) * b fits in 64 bits, i.e. for spans under ~5 hours
+static uint64_t freq_mul_div(uint64_t a, uint64_t b, uint64_t divisor) {
+    return (a / divisor) * b + (a % divisor) * b / divisor;
+}
+
+void hal_freq_init(uint32_t pin) {
+    if (pin >= 32) return;
+    hal_backend_auto_select();
+    
+    uint32_t timer_base = FPGA_BASE_ADDR + TIMER_BASE_OFFSET;
+    if (!(REG_READ(timer_base + TIMER_CONTROL_REG) & TIMER_CONTROL_ENABLE)) {
+        REG_WRITE(timer_base + TIMER_CONTROL_REG, TIMER_CONTROL_ENABLE);  // Edge stamps need it
+    }
+    
+    hal_gpio_set_direction(pin, GPIO_INPUT);
+    REG_WRITE(FPGA_BASE_ADDR + GPIO_BASE_OFFSET + GPIO_EDGE_CONTROL_REG,
+              GPIO_EDGE_ENABLE | (pin & GPIO_EDGE_PIN_MASK));
+}
+
+// Wait until `target` on the 64-bit timebase, accumulating edges from *last
+static uint64_t freq_run_gate(freq_sample_t* last, uint64_t target) {
+    uint64_t edges = 0;
+    
+    do {
+        uint64_t remaining = target > last->now ? target - last->now : 0;
+        uint64_t chunk_us = remaining / FREQ_TICKS_PER_US;
+        hal_delay_us(chunk_us > FREQ_CHUNK_US ? FREQ_CHUNK_US : (uint32_t)chunk_us);
+    
+        freq_sample_t sample;
+        freq_sample(&sample);
+        edges += (uint32_t)(sample.count - last->count);
+        *last = sample;
+    } while (last->now < target);
+    
+    return edges;
+}
+
+int hal_freq_measure(hal_freq_mode_t mode, uint32_t gate_us, uint32_t gate_count,
+                     hal_freq_result_t* result) {
+    if (!result || gate_us == 0 || gate_count == 0) return -1;
+    
+    *result = (hal_freq_result_t){0};
+    result->min_millihertz = UINT64_MAX;
+    uint64_t gate_ticks = (uint64_t)gate_us * FREQ_TICKS_PER_US;
+    
+    freq_sample_t last;
+    freq_sample(&last);
+    if (mode == HAL_FREQ_RECIPROCAL && last.count == 0) {
+        // No edge to stamp the start from yet: give the input one gate
+        freq_run_gate(&last, last.now + gate_ticks);
+        if (last.count == 0) return -1;
+    }
+    
+    for (uint32_t gate = 0; gate < gate_count; gate++) {
+        freq_sample_t start = last;
+        uint64_t edges = freq_run_gate(&last, start.now + gate_ticks);
+    
+        uint64_t ticks = mode == HAL_FREQ_RECIPROCAL ? (uint32_t)(last.stamp - start.stamp)
+                                                     : last.now - start.now;
+        if (ticks == 0 || (mode == HAL_FREQ_RECIPROCAL && edges == 0)) {
+            return -1;  // Gate shorter than one input period
+        }
+    
+        uint64_t millihertz = freq_mul_div(edges, FREQ_MILLIHERTZ_PER_TICK_RATE, ticks);
+        if (millihertz < result->min_millihertz) result->min_millihertz = millihertz;
+        if (millihertz > result->max_millihertz) result->max_millihertz = millihertz;
+        result->edges += edges;
+        result->ticks += ticks;
+        result->gates++;
+    }
+    
+    if (result->edges == 0) return -1;
+    
+    result->millihertz = freq_mul_div(result->edges, FREQ_MILLIHERTZ_PER_TICK_RATE, result->ticks);
+    result->hz = (result->millihertz + 500) / 1000;
+    return 0;
+}
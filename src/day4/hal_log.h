@@ -0,0 +1,51 @@
+#ifndef HAL_LOG_H
+#define HAL_LOG_H
+
+#include <stdio.h>
+#include "fpga_hal.h"
+
+// Compile-time log ceiling. Anything above it expands to nothing, so a
+// release build carries no format strings and no stdio references.
+#ifndef HAL_LOG_LEVEL
+    #ifdef NDEBUG
+        #define HAL_LOG_LEVEL HAL_LOG_LEVEL_NONE
+    #else
+        #define HAL_LOG_LEVEL HAL_LOG_LEVEL_DEBUG
+    #endif
+#endif
+
+// Runtime threshold, only consulted for levels that survived compilation
+extern uint32_t hal_log_runtime_level;
+
+#define HAL_LOG_EMIT(level, ...) \
+    do { \
+        if ((level) <= hal_log_runtime_level) { \
+            printf(__VA_ARGS__); \
+        } \
+    } while (0)
+
+#if HAL_LOG_LEVEL >= HAL_LOG_LEVEL_ERROR
+    #define HAL_LOG_ERROR(...) HAL_LOG_EMIT(HAL_LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+    #define HAL_LOG_ERROR(...) ((void)0)
+#endif
+
+#if HAL_LOG_LEVEL >= HAL_LOG_LEVEL_WARN
+    #define HAL_LOG_WARN(...) HAL_LOG_EMIT(HAL_LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+    #define HAL_LOG_WARN(...) ((void)0)
+#endif
+
+#if HAL_LOG_LEVEL >= HAL_LOG_LEVEL_INFO
+    #define HAL_LOG_INFO(...) HAL_LOG_EMIT(HAL_LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+    #define HAL_LOG_INFO(...) ((void)0)
+#endif
+
+#if HAL_LOG_LEVEL >= HAL_LOG_LEVEL_DEBUG
+    #define HAL_LOG_DEBUG(...) HAL_LOG_EMIT(HAL_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+    #define HAL_LOG_DEBUG(...) ((void)0)
+#endif
+
+#endif // HAL_LOG_H
@@ -0,0 +1,101 @@
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "fpga_hal_regs.h"
+#include "hal_backend.h"
+
+// Live register viewer for a shared simulated board. Attaches to the same
+// shared-memory object (or mapped file) as validation_framework / hal_test
+// and prints the registers without disturbing the simulation.
+//
+//   hal_regview                    one snapshot of /fpga_hal_sim
+//   hal_regview --interval=200     refresh every 200 ms until interrupted
+//   hal_regview --file=regs.bin    view a file-mapped register file
+//   hal_regview --unlink           remove the shared-memory object
+
+typedef struct {
+    const char* name;
+    uint32_t offset;
+} regview_entry_t;
+
+static const regview_entry_t regview_registers[] = {
+    {"GPIO_DATA",     GPIO_BASE_OFFSET + GPIO_DATA_REG},
+    {"GPIO_DIR",      GPIO_BASE_OFFSET + GPIO_DIR_REG},
+    {"GPIO_INT",      GPIO_BASE_OFFSET + GPIO_INT_REG},
+    {"GPIO_EDGE_CTL", GPIO_BASE_OFFSET + GPIO_EDGE_CONTROL_REG},
+    {"GPIO_EDGE_CNT", GPIO_BASE_OFFSET + GPIO_EDGE_COUNT_REG},
+    {"GPIO_EDGE_TIME", GPIO_BASE_OFFSET + GPIO_EDGE_TIME_REG},
+    {"UART_DATA",     UART_BASE_OFFSET + UART_DATA_REG},
+    {"UART_STATUS",   UART_BASE_OFFSET + UART_STATUS_REG},
+    {"UART_CONTROL",  UART_BASE_OFFSET + UART_CONTROL_REG},
+    {"UART_BAUD",     UART_BASE_OFFSET + UART_BAUD_REG},
+    {"TIMER_COUNT",   TIMER_BASE_OFFSET + TIMER_COUNT_REG},
+    {"TIMER_COMPARE", TIMER_BASE_OFFSET + TIMER_COMPARE_REG},
+    {"TIMER_CONTROL", TIMER_BASE_OFFSET + TIMER_CONTROL_REG},
+    {"TIMER_STATUS",  TIMER_BASE_OFFSET + TIMER_STATUS_REG},
+    {"ADC_DATA",      ADC_BASE_OFFSET + ADC_DATA_REG},
+    {"ADC_CONTROL",   ADC_BASE_OFFSET + ADC_CONTROL_REG},
+    {"ADC_STATUS",    ADC_BASE_OFFSET + ADC_STATUS_REG},
+};
+
+static void regview_print(uint32_t snapshot) {
+    printf("--- snapshot %u (attached processes: %u) ---\n",
+           (unsigned)snapshot, (unsigned)hal_mapped_attach_count());
+    
+    for (size_t i = 0; i < sizeof(regview_registers) / sizeof(regview_registers[0]); i++) {
+        const regview_entry_t* reg = &regview_registers[i];
+        uint32_t addr = FPGA_BASE_ADDR + reg->offset;
+        printf("%-14s 0x%08X = 0x%08X\n", reg->name, (unsigned)addr,
+               (unsigned)hal_sim_peek(addr));
+    }
+    
+    fflush(stdout);
+}
+
+int main(int argc, char* argv[]) {
+    const char* shm_name = getenv("FPGA_HAL_SHM_NAME");
+    const char* file_path = NULL;
+    uint32_t interval_ms = 0;
+    uint32_t count = 0;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--shm=", 6) == 0) {
+            shm_name = argv[i] + 6;
+        } else if (strncmp(argv[i], "--file=", 7) == 0) {
+            file_path = argv[i] + 7;
+        } else if (strncmp(argv[i], "--interval=", 11) == 0) {
+            interval_ms = (uint32_t)strtoul(argv[i] + 11, NULL, 10);
+        } else if (strncmp(argv[i], "--count=", 8) == 0) {
+            count = (uint32_t)strtoul(argv[i] + 8, NULL, 10);
+        } else if (strcmp(argv[i], "--unlink") == 0) {
+            return hal_shared_unlink(shm_name) == 0 ? 0 : 1;
+        } else {
+            fprintf(stderr, "Usage: %s [--shm=NAME | --file=PATH] [--interval=MS] [--count=N] [--unlink]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    
+    int status = file_path ? hal_mapped_observe(file_path)
+                           : hal_shared_observe(shm_name ? shm_name : "/fpga_hal_sim");
+    if (status != 0) {
+        return 1;
+    }
+    
+    if (interval_ms == 0) {
+        count = 1;
+    }
+    
+    struct timespec pause = {interval_ms / 1000, (long)(interval_ms % 1000) * 1000000L};
+    for (uint32_t snapshot = 0; count == 0 || snapshot < count; snapshot++) {
+        regview_print(snapshot);
+        if (count == 0 || snapshot + 1 < count) {
+            nanosleep(&pause, NULL);
+        }
+    }
+    
+    hal_mapped_close();
+    return 0;
+}
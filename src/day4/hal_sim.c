@@ -0,0 +1,845 @@
+#define _POSIX_C_SOURCE 200112L
+#include <stdlib.h>
+#include "hal_backend.h"
+#include "hal_sim.h"
+#include "fpga_hal_regs.h"
+
+#ifndef __riscv
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#define SIM_HAVE_REALTIME 1
+#else
+#define SIM_HAVE_REALTIME 0
+#endif
+
+// In-process simulation of the FPGA register window
+static uint32_t sim_storage[FPGA_WINDOW_WORDS];
+static uint32_t* sim_window = sim_storage;
+
+// Event queue: binary min-heap ordered by time, then by scheduling order so
+// simultaneous events always run in the same order
+typedef enum {
+    SIM_PERIPH_UART,
+    SIM_PERIPH_TIMER,
+    SIM_PERIPH_ADC,
+    SIM_PERIPH_COUNT
+} sim_periph_t;
+
+typedef enum {
+    SIM_EVENT_UART_TX_DONE,
+    SIM_EVENT_UART_RX_BYTE,
+    SIM_EVENT_TIMER_MATCH,
+    SIM_EVENT_ADC_DONE
+} sim_event_type_t;
+
+typedef struct {
+    uint64_t time_ns;
+    uint32_t sequence;
+    sim_event_type_t type;
+    uint32_t arg;
+} sim_event_t;
+
+#define SIM_EVENT_CAPACITY 256
+#define SIM_UART_FIFO_SIZE 256
+#define SIM_UART_LINE_SIZE 4096   // Injected bytes still on the wire
+
+// Each peripheral may hold an equal share of the queue, so one that floods
+// it can never crowd out another's completion event. Every model keeps at
+// most one event per pending completion, far below its share.
+#define SIM_EVENT_SHARE (SIM_EVENT_CAPACITY / SIM_PERIPH_COUNT)
+
+typedef struct {
+    uint64_t now_ns;
+    uint32_t next_sequence;
+    sim_event_t events[SIM_EVENT_CAPACITY];
+    uint32_t event_count;
+    uint32_t pending[SIM_PERIPH_COUNT];
+    
+    // Timer: count = count_base + elapsed ticks since enable_ns while enabled
+    uint32_t timer_count_base;
+    uint64_t timer_enable_ns;
+    uint32_t timer_generation;    // Invalidates stale match events
+    
+    // UART
+    uint32_t uart_baud;
+    char uart_rx[SIM_UART_FIFO_SIZE];
+    uint32_t uart_rx_head;
+    uint32_t uart_rx_count;
+    char uart_line[SIM_UART_LINE_SIZE];  // Arriving one character time apart,
+    uint32_t uart_line_head;             // with one RX event for the next byte
+    uint32_t uart_line_count;
+    char uart_tx[SIM_UART_FIFO_SIZE];
+    uint32_t uart_tx_head;
+    uint32_t uart_tx_count;
+    uint32_t uart_tx_total;
+    uint8_t uart_tx_fifo[UART_TX_FIFO_DEPTH];
+    uint32_t uart_tx_fifo_head;
+    uint32_t uart_tx_fifo_count;
+    int uart_tx_shifting;
+    int uart_status_polled;       // Last UART access was a status read
+    
+    int initialized;
+    
+    // Real-time pacing: virtual time is held to wall time via absolute sleeps
+    int realtime;
+    uint64_t realtime_anchor_ns;  // Wall clock at virtual time zero
+    uint64_t realtime_paced_ns;   // Virtual time of the last sleep
+    
+    // GPIO edge counter: count = edge_base + edges of the selected pin's
+    // clock since edge_start_ns, computed from the frequency, not per edge
+    uint64_t clock_millihertz[32];
+    uint32_t edge_base;
+    uint64_t edge_start_ns;
+    uint64_t edge_last_ns;        // Time of the last edge counted in edge_base
+    
+    // ADC
+    hal_sim_adc_source_t adc_source;
+    void* adc_context;
+    uint16_t adc_level[ADC_CHANNEL_COUNT];
+    uint32_t adc_noise_state;
+} sim_state_t;
+
+static sim_state_t sim;
+
+// Window accesses are atomic so several processes can share one mapped window
+static inline uint32_t sim_load(uint32_t index) {
+    return __atomic_load_n(&sim_window[index], __ATOMIC_ACQUIRE);
+}
+
+static inline void sim_store(uint32_t index, uint32_t value) {
+    __atomic_store_n(&sim_window[index], value, __ATOMIC_RELEASE);
+}
+
+static inline uint32_t sim_reg(uint32_t offset) {
+    return sim_load(offset >> 2);
+}
+
+static inline void sim_set_reg(uint32_t offset, uint32_t value) {
+    sim_store(offset >> 2, value);
+}
+
+static inline void sim_set_bits(uint32_t offset, uint32_t bits) {
+    __atomic_fetch_or(&sim_window[offset >> 2], bits, __ATOMIC_ACQ_REL);
+}
+
+static inline void sim_clear_bits(uint32_t offset, uint32_t bits) {
+    __atomic_fetch_and(&sim_window[offset >> 2], ~bits, __ATOMIC_ACQ_REL);
+}
+
+// One lock around the whole model so threads may drive different
+// peripherals at once; every public entry point that touches sim takes it.
+// On hosts it is a mutex, so waiters block rather than spin. Real-time
+// pacing sleeps with the lock released (see sim_pace()).
+#if SIM_HAVE_REALTIME
+static pthread_mutex_t sim_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void sim_acquire(void) {
+    pthread_mutex_lock(&sim_lock);
+}
+
+static void sim_release(void) {
+    pthread_mutex_unlock(&sim_lock);
+}
+#else
+static uint8_t sim_lock;
+
+static void sim_acquire(void) {
+    while (__atomic_test_and_set(&sim_lock, __ATOMIC_ACQUIRE)) {
+    }
+}
+
+static void sim_release(void) {
+    __atomic_clear(&sim_lock, __ATOMIC_RELEASE);
+}
+#endif
+
+// Event queue
+static sim_periph_t sim_event_periph(sim_event_type_t type) {
+    switch (type) {
+        case SIM_EVENT_UART_TX_DONE:
+        case SIM_EVENT_UART_RX_BYTE: return SIM_PERIPH_UART;
+        case SIM_EVENT_TIMER_MATCH:  return SIM_PERIPH_TIMER;
+        default:                     return SIM_PERIPH_ADC;
+    }
+}
+
+static int sim_event_before(const sim_event_t* a, const sim_event_t* b) {
+    if (a->time_ns != b->time_ns) return a->time_ns < b->time_ns;
+    return (int32_t)(a->sequence - b->sequence) < 0;
+}
+
+static int sim_schedule(uint64_t time_ns, sim_event_type_t type, uint32_t arg) {
+    if (sim.pending[sim_event_periph(type)] >= SIM_EVENT_SHARE) return -1;
+    
+    sim_event_t event = {time_ns, sim.next_sequence++, type, arg};
+    uint32_t i = sim.event_count++;
+    while (i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if (!sim_event_before(&event, &sim.events[parent])) break;
+        sim.events[i] = sim.events[parent];
+        i = parent;
+    }
+    sim.events[i] = event;
+    sim.pending[sim_event_periph(type)]++;
+    return 0;
+}
+
+// Place event at slot i or below, assuming both subtrees are heaps
+static void sim_sift_down(uint32_t i, sim_event_t event) {
+    for (;;) {
+        uint32_t child = 2 * i + 1;
+        if (child >= sim.event_count) break;
+        if (child + 1 < sim.event_count &&
+            sim_event_before(&sim.events[child + 1], &sim.events[child])) {
+            child++;
+        }
+        if (!sim_event_before(&sim.events[child], &event)) break;
+        sim.events[i] = sim.events[child];
+        i = child;
+    }
+    sim.events[i] = event;
+}
+
+static sim_event_t sim_pop(void) {
+    sim_event_t top = sim.events[0];
+    sim_event_t last = sim.events[--sim.event_count];
+    if (sim.event_count > 0) {
+        sim_sift_down(0, last);
+    }
+    
+    sim.pending[sim_event_periph(top.type)]--;
+    return top;
+}
+
+// Drop every queued event of one type and rebuild the heap
+static void sim_cancel(sim_event_type_t type) {
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < sim.event_count; i++) {
+        if (sim.events[i].type == type) {
+            sim.pending[sim_event_periph(type)]--;
+        } else {
+            sim.events[kept++] = sim.events[i];
+        }
+    }
+    if (kept == sim.event_count) return;
+    
+    sim.event_count = kept;
+    for (uint32_t i = kept / 2; i-- > 0;) {
+        sim_sift_down(i, sim.events[i]);
+    }
+}
+
+// Timer model
+static int sim_timer_enabled(void) {
+    return (sim_reg(TIMER_BASE_OFFSET + TIMER_CONTROL_REG) & TIMER_CONTROL_ENABLE) != 0;
+}
+
+// Count at time_ns (now, or an earlier instant for capture registers)
+static uint32_t sim_timer_count_at(uint64_t time_ns) {
+    if (!sim_timer_enabled() || time_ns < sim.timer_enable_ns) return sim.timer_count_base;
+    
+    uint64_t ticks = (time_ns - sim.timer_enable_ns) / (1000000000u / TIMER_FREQUENCY_HZ);
+    return sim.timer_count_base + (uint32_t)ticks;
+}
+
+static uint32_t sim_timer_count(void) {
+    return sim_timer_count_at(sim.now_ns);
+}
+
+// Called whenever count, compare or enable changes. Superseded matches are
+// dropped; left queued (up to a full wrap away) they fill the event queue.
+static void sim_timer_reschedule(void) {
+    sim.timer_generation++;
+    sim_cancel(SIM_EVENT_TIMER_MATCH);
+    if (!sim_timer_enabled()) return;
+    
+    const uint64_t tick_ns = 1000000000u / TIMER_FREQUENCY_HZ;
+    uint32_t count = sim_timer_count();
+    uint32_t compare = sim_reg(TIMER_BASE_OFFSET + TIMER_COMPARE_REG);
+    uint64_t distance = (uint32_t)(compare - count);
+    if (distance == 0) distance = 1ull << 32;  // Next match is a full wrap away
+    
+    // Count changes on tick boundaries measured from the enable time
+    uint64_t tick_start = sim.now_ns - (sim.now_ns - sim.timer_enable_ns) % tick_ns;
+    sim_schedule(tick_start + distance * tick_ns, SIM_EVENT_TIMER_MATCH, sim.timer_generation);
+}
+
+// UART model
+static uint64_t sim_uart_char_ns(void) {
+    uint32_t baud = sim.uart_baud ? sim.uart_baud : HAL_SIM_UART_DEFAULT_BAUD;
+    return (10ull * 1000000000ull) / baud;  // Start + 8 data + stop bits
+}
+
+static void sim_uart_capture_tx(char c) {
+    sim.uart_tx[(sim.uart_tx_head + sim.uart_tx_count) % SIM_UART_FIFO_SIZE] = c;
+    if (sim.uart_tx_count < SIM_UART_FIFO_SIZE) {
+        sim.uart_tx_count++;
+    } else {
+        sim.uart_tx_head = (sim.uart_tx_head + 1) % SIM_UART_FIFO_SIZE;  // Keep the newest
+    }
+    sim.uart_tx_total++;
+}
+
+static void sim_uart_update_status(void) {
+    uint32_t status = UART_BASE_OFFSET + UART_STATUS_REG;
+    int enabled = (sim_reg(UART_BASE_OFFSET + UART_CONTROL_REG) & UART_CONTROL_ENABLE) != 0;
+    
+    if (enabled && sim.uart_tx_fifo_count < UART_TX_FIFO_DEPTH) {
+        sim_set_bits(status, UART_STATUS_TX_READY);
+    } else {
+        sim_clear_bits(status, UART_STATUS_TX_READY);
+    }
+    
+    if (!sim.uart_tx_shifting && sim.uart_tx_fifo_count == 0) {
+        sim_set_bits(status, UART_STATUS_TX_EMPTY);
+    } else {
+        sim_clear_bits(status, UART_STATUS_TX_EMPTY);
+    }
+}
+
+// Move the next FIFO byte into the shifter
+static void sim_uart_start_shift(void) {
+    if (sim.uart_tx_fifo_count == 0) {
+        sim.uart_tx_shifting = 0;
+        return;
+    }
+    
+    uint8_t byte = sim.uart_tx_fifo[sim.uart_tx_fifo_head];
+    sim.uart_tx_fifo_head = (sim.uart_tx_fifo_head + 1) % UART_TX_FIFO_DEPTH;
+    sim.uart_tx_fifo_count--;
+    sim.uart_tx_shifting = 1;
+    sim_schedule(sim.now_ns + sim_uart_char_ns(), SIM_EVENT_UART_TX_DONE, byte);
+}
+
+// Edge counter model. Edge k of a clock started at edge_start_ns falls at
+// edge_start_ns + k / f, so the count is floor(elapsed * f). Frequencies are
+// in millihertz and times in ns, hence the 1e12 scale.
+#define SIM_MILLIHERTZ_NS 1000000000000ull
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 sim_u128_t;
+#endif
+
+static uint64_t sim_mul_div(uint64_t a, uint64_t b, uint64_t divisor) {
+#ifdef __SIZEOF_INT128__
+    return (uint64_t)((sim_u128_t)a * b / divisor);
+#else
+    return (uint64_t)((long double)a * (long double)b / (long double)divisor);
+#endif
+}
+
+static uint64_t sim_edge_frequency(void) {
+    uint32_t control = sim_reg(GPIO_BASE_OFFSET + GPIO_EDGE_CONTROL_REG);
+    if (!(control & GPIO_EDGE_ENABLE)) return 0;
+    return sim.clock_millihertz[control & GPIO_EDGE_PIN_MASK];
+}
+
+static uint64_t sim_edges_since_start(uint64_t frequency) {
+    if (frequency == 0) return 0;
+    return sim_mul_div(sim.now_ns - sim.edge_start_ns, frequency, SIM_MILLIHERTZ_NS);
+}
+
+// First instant at which edge k has happened
+static uint64_t sim_edge_time(uint64_t k, uint64_t frequency) {
+    uint64_t offset = sim_mul_div(k, SIM_MILLIHERTZ_NS, frequency);
+    if (sim_mul_div(offset, frequency, SIM_MILLIHERTZ_NS) < k) offset++;
+    return sim.edge_start_ns + offset;
+}
+
+// Fold the edges so far into edge_base, e.g. before the frequency changes
+static void sim_edge_rebase(void) {
+    uint64_t frequency = sim_edge_frequency();
+    uint64_t edges = sim_edges_since_start(frequency);
+    if (edges > 0) {
+        sim.edge_last_ns = sim_edge_time(edges, frequency);
+        sim.edge_base += (uint32_t)edges;
+    }
+    sim.edge_start_ns = sim.now_ns;
+}
+
+// Reading the count latches the timer value of the last counted edge
+static uint32_t sim_edge_latch(void) {
+    uint64_t frequency = sim_edge_frequency();
+    uint64_t edges = sim_edges_since_start(frequency);
+    uint32_t count = sim.edge_base + (uint32_t)edges;
+    
+    uint64_t last_ns = edges > 0 ? sim_edge_time(edges, frequency) : sim.edge_last_ns;
+    if (edges > 0 || sim.edge_base > 0) {
+        sim_set_reg(GPIO_BASE_OFFSET + GPIO_EDGE_TIME_REG, sim_timer_count_at(last_ns));
+    }
+    sim_set_reg(GPIO_BASE_OFFSET + GPIO_EDGE_COUNT_REG, count);
+    return count;
+}
+
+// ADC model
+static uint16_t sim_adc_default_source(uint32_t channel, uint64_t time_ns, void* context) {
+    (void)time_ns;
+    (void)context;
+    
+    sim.adc_noise_state = sim.adc_noise_state * 1664525u + 1013904223u;
+    int32_t noise = (int32_t)((sim.adc_noise_state >> 29) & 0x7) - 4;  // -4..+3 LSB
+    int32_t value = (int32_t)sim.adc_level[channel] + noise;
+    
+    if (value < 0) value = 0;
+    if (value > 4095) value = 4095;
+    return (uint16_t)value;
+}
+
+#if SIM_HAVE_REALTIME
+static uint64_t sim_wall_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+// In real-time mode, sleep until the wall clock reaches virtual time_ns
+// before the model moves there. Sleeping to an absolute time keeps long runs
+// from drifting; small steps are batched so register accesses don't each
+// cost a system call. The lock is dropped for the sleep so other threads
+// keep driving their peripherals; returns 1 if it slept, and the caller
+// must then look at the model again.
+static int sim_pace(uint64_t time_ns) {
+#if SIM_HAVE_REALTIME
+    if (!sim.realtime || time_ns <= sim.realtime_paced_ns ||
+        time_ns - sim.realtime_paced_ns < HAL_SIM_REALTIME_SLICE_NS) {
+        return 0;
+    }
+    
+    uint64_t wake = sim.realtime_anchor_ns + time_ns;
+    struct timespec ts = {(time_t)(wake / 1000000000ull), (long)(wake % 1000000000ull)};
+    sim_release();
+    int rc;
+    do {
+        rc = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    } while (rc == EINTR);
+    sim_acquire();
+    if (time_ns > sim.realtime_paced_ns) {
+        sim.realtime_paced_ns = time_ns;
+    }
+    return 1;
+#else
+    (void)time_ns;
+    return 0;
+#endif
+}
+
+static int sim_set_realtime(int enable) {
+#if SIM_HAVE_REALTIME
+    if (enable && !sim.realtime) {
+        sim.realtime_anchor_ns = sim_wall_ns() - sim.now_ns;
+        sim.realtime_paced_ns = sim.now_ns;
+    }
+    sim.realtime = enable;
+    return 0;
+#else
+    return enable ? -1 : 0;
+#endif
+}
+
+static void sim_run_event(const sim_event_t* event) {
+    sim.now_ns = event->time_ns;
+    
+    switch (event->type) {
+        case SIM_EVENT_UART_TX_DONE:
+            sim_uart_capture_tx((char)event->arg);
+            sim_uart_start_shift();
+            sim_uart_update_status();
+            break;
+        
+        case SIM_EVENT_UART_RX_BYTE: {
+            char byte = sim.uart_line[sim.uart_line_head];
+            sim.uart_line_head = (sim.uart_line_head + 1) % SIM_UART_LINE_SIZE;
+            sim.uart_line_count--;
+            if (sim.uart_line_count > 0) {
+                sim_schedule(sim.now_ns + sim_uart_char_ns(), SIM_EVENT_UART_RX_BYTE, 0);
+            }
+            
+            if (sim.uart_rx_count == 0) {
+                sim_set_reg(UART_BASE_OFFSET + UART_DATA_REG, (uint8_t)byte);
+            }
+            if (sim.uart_rx_count < SIM_UART_FIFO_SIZE) {
+                sim.uart_rx[(sim.uart_rx_head + sim.uart_rx_count) % SIM_UART_FIFO_SIZE] = byte;
+                sim.uart_rx_count++;
+            }
+            sim_set_bits(UART_BASE_OFFSET + UART_STATUS_REG, UART_STATUS_RX_VALID);
+            break;
+        }
+        
+        case SIM_EVENT_TIMER_MATCH:
+            if (event->arg != sim.timer_generation) break;  // Superseded
+            sim_set_bits(TIMER_BASE_OFFSET + TIMER_STATUS_REG, TIMER_STATUS_MATCH);
+            sim_timer_reschedule();
+            break;
+        
+        case SIM_EVENT_ADC_DONE: {
+            hal_sim_adc_source_t source = sim.adc_source ? sim.adc_source : sim_adc_default_source;
+            uint16_t sample = source(event->arg, sim.now_ns, sim.adc_context) & 0x0FFF;
+            sim_set_reg(ADC_BASE_OFFSET + ADC_DATA_REG, sample);
+            sim_set_bits(ADC_BASE_OFFSET + ADC_STATUS_REG, ADC_STATUS_DONE);
+            break;
+        }
+    }
+}
+
+// Advance the clock to target_ns, running every event due on the way
+static void sim_run_until(uint64_t target_ns) {
+    for (;;) {
+        int due = sim.event_count > 0 && sim.events[0].time_ns <= target_ns;
+        if (sim_pace(due ? sim.events[0].time_ns : target_ns)) continue;
+        if (!due) break;
+        
+        sim_event_t event = sim_pop();
+        sim_run_event(&event);
+    }
+    if (target_ns > sim.now_ns) {
+        sim.now_ns = target_ns;
+    }
+}
+
+// A poll that finds its bit clear waits for that peripheral's next event
+static void sim_wait_for(sim_periph_t periph) {
+    while (sim.pending[periph] > 0) {
+        if (sim_pace(sim.events[0].time_ns)) continue;
+        
+        sim_event_t event = sim_pop();
+        sim_run_event(&event);
+        if (sim_event_periph(event.type) == periph) break;
+    }
+}
+
+static void sim_bus_access(void) {
+    sim_run_until(sim.now_ns + HAL_SIM_BUS_ACCESS_NS);
+}
+
+static void sim_init_defaults(void) {
+    sim.initialized = 1;
+    for (uint32_t channel = 0; channel < ADC_CHANNEL_COUNT; channel++) {
+        sim.adc_level[channel] = (uint16_t)(1241 + 310 * channel);  // 1.0 V + 0.25 V steps
+    }
+    sim.adc_noise_state = 0x1234567u;
+    
+    const char* realtime = getenv("FPGA_HAL_SIM_REALTIME");
+    if (realtime && realtime[0] == '1') {
+        sim_set_realtime(1);
+    }
+}
+
+void hal_sim_attach(uint32_t* window) {
+    sim_window = window ? window : sim_storage;
+}
+
+void hal_sim_reset(void) {
+    sim_acquire();
+    for (uint32_t i = 0; i < FPGA_WINDOW_WORDS; i++) {
+        sim_store(i, 0);
+    }
+    
+    hal_sim_adc_source_t source = sim.adc_source;
+    void* context = sim.adc_context;
+    sim = (sim_state_t){0};
+    sim.adc_source = source;
+    sim.adc_context = context;
+    sim_init_defaults();
+    sim_release();
+}
+
+uint32_t hal_sim_peek(uint32_t addr) {
+    uint32_t offset = addr - FPGA_BASE_ADDR;
+    if (offset >= FPGA_WINDOW_SIZE) return 0;
+    
+    return sim_load(offset >> 2);
+}
+
+static uint32_t sim_read(uint32_t offset) {
+    if (!sim.initialized) sim_init_defaults();
+    sim_bus_access();
+    
+    switch (offset) {
+        case UART_BASE_OFFSET + UART_STATUS_REG:
+            // A second status read with no UART access in between is a spin
+            // (on TX_READY, TX_EMPTY or RX_VALID): let the line move on
+            if (sim.uart_status_polled) {
+                sim_wait_for(SIM_PERIPH_UART);
+            }
+            sim.uart_status_polled = 1;
+            return sim_load(offset >> 2);
+        
+        case UART_BASE_OFFSET + UART_DATA_REG:
+            // Reading pops the received byte and exposes the next one
+            sim.uart_status_polled = 0;
+            if (sim.uart_rx_count > 0) {
+                uint32_t value = (uint8_t)sim.uart_rx[sim.uart_rx_head];
+                sim.uart_rx_head = (sim.uart_rx_head + 1) % SIM_UART_FIFO_SIZE;
+                sim.uart_rx_count--;
+                if (sim.uart_rx_count > 0) {
+                    sim_set_reg(offset, (uint8_t)sim.uart_rx[sim.uart_rx_head]);
+                } else {
+                    sim_clear_bits(UART_BASE_OFFSET + UART_STATUS_REG, UART_STATUS_RX_VALID);
+                }
+                return value;
+            }
+            break;
+        
+        case TIMER_BASE_OFFSET + TIMER_COUNT_REG:
+            sim_set_reg(offset, sim_timer_count());  // Keep viewers up to date
+            break;
+        
+        case GPIO_BASE_OFFSET + GPIO_EDGE_COUNT_REG:
+            return sim_edge_latch();
+        
+        case TIMER_BASE_OFFSET + TIMER_STATUS_REG:
+            if (!(sim_reg(offset) & TIMER_STATUS_MATCH)) {
+                sim_wait_for(SIM_PERIPH_TIMER);
+            }
+            break;
+        
+        case ADC_BASE_OFFSET + ADC_STATUS_REG:
+            if (!(sim_reg(offset) & ADC_STATUS_DONE)) {
+                sim_wait_for(SIM_PERIPH_ADC);
+            }
+            break;
+        
+        default:
+            break;
+    }
+    
+    return sim_load(offset >> 2);
+}
+
+static void sim_write(uint32_t offset, uint32_t value) {
+    if (!sim.initialized) sim_init_defaults();
+    sim_bus_access();
+    
+    // The GPIO set/clear/toggle aliases act on the data register, like the RTL.
+    // Atomic RMW keeps them glitch-free against writers in other processes.
+    uint32_t gpio_data = GPIO_BASE_OFFSET + GPIO_DATA_REG;
+    switch (offset) {
+        case GPIO_BASE_OFFSET + GPIO_SET_REG:
+            sim_set_bits(gpio_data, value);
+            break;
+        
+        case GPIO_BASE_OFFSET + GPIO_CLEAR_REG:
+            sim_clear_bits(gpio_data, value);
+            break;
+        
+        case GPIO_BASE_OFFSET + GPIO_TOGGLE_REG:
+            __atomic_fetch_xor(&sim_window[gpio_data >> 2], value, __ATOMIC_ACQ_REL);
+            break;
+        
+        case GPIO_BASE_OFFSET + GPIO_BSRR_LO_REG:
+        case GPIO_BASE_OFFSET + GPIO_BSRR_HI_REG: {
+            // Set and reset land in one update, as in the RTL
+            uint32_t shift = (offset == GPIO_BASE_OFFSET + GPIO_BSRR_HI_REG) ? GPIO_BSRR_PINS : 0;
+            uint32_t set = (value & 0xFFFFu) << shift;
+            uint32_t reset = (value >> 16) << shift;
+            uint32_t* data = &sim_window[gpio_data >> 2];
+            uint32_t old = __atomic_load_n(data, __ATOMIC_ACQUIRE);
+            while (!__atomic_compare_exchange_n(data, &old, (old & ~reset) | set, 0,
+                                                __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            }
+            break;
+        }
+        
+        case GPIO_BASE_OFFSET + GPIO_EDGE_CONTROL_REG:
+            sim_set_reg(offset, value & (GPIO_EDGE_ENABLE | GPIO_EDGE_PIN_MASK));
+            sim_set_reg(GPIO_BASE_OFFSET + GPIO_EDGE_COUNT_REG, 0);
+            sim_set_reg(GPIO_BASE_OFFSET + GPIO_EDGE_TIME_REG, 0);
+            sim.edge_base = 0;
+            sim.edge_start_ns = sim.now_ns;
+            sim.edge_last_ns = sim.now_ns;
+            break;
+        
+        case GPIO_BASE_OFFSET + GPIO_EDGE_COUNT_REG:
+        case GPIO_BASE_OFFSET + GPIO_EDGE_TIME_REG:
+            break;  // Read-only
+        
+        case UART_BASE_OFFSET + UART_DATA_REG:
+            // Bytes queue in the TX FIFO; writes to a full FIFO are lost
+            sim.uart_status_polled = 0;
+            if (!(sim_reg(UART_BASE_OFFSET + UART_CONTROL_REG) & UART_CONTROL_ENABLE)) break;
+            if (sim.uart_tx_fifo_count < UART_TX_FIFO_DEPTH) {
+                sim.uart_tx_fifo[(sim.uart_tx_fifo_head + sim.uart_tx_fifo_count) %
+                                 UART_TX_FIFO_DEPTH] = (uint8_t)value;
+                sim.uart_tx_fifo_count++;
+                if (!sim.uart_tx_shifting) {
+                    sim_uart_start_shift();
+                }
+            }
+            sim_uart_update_status();
+            break;
+        
+        case UART_BASE_OFFSET + UART_CONTROL_REG:
+            sim_set_reg(offset, value);
+            sim_uart_update_status();
+            break;
+        
+        case UART_BASE_OFFSET + UART_BAUD_REG:
+            sim_set_reg(offset, value);
+            sim.uart_baud = value;
+            break;
+        
+        case TIMER_BASE_OFFSET + TIMER_COUNT_REG:
+            sim.timer_count_base = value;
+            sim.timer_enable_ns = sim.now_ns;
+            sim_set_reg(offset, value);
+            sim_timer_reschedule();
+            break;
+        
+        case TIMER_BASE_OFFSET + TIMER_COMPARE_REG:
+            sim_set_reg(offset, value);
+            sim_timer_reschedule();
+            break;
+        
+        case TIMER_BASE_OFFSET + TIMER_CONTROL_REG: {
+            int was_enabled = sim_timer_enabled();
+            if (was_enabled && !(value & TIMER_CONTROL_ENABLE)) {
+                sim.timer_count_base = sim_timer_count();  // Freeze
+            } else if (!was_enabled && (value & TIMER_CONTROL_ENABLE)) {
+                sim.timer_enable_ns = sim.now_ns;
+            }
+            sim_set_reg(offset, value);
+            sim_timer_reschedule();
+            break;
+        }
+        
+        case TIMER_BASE_OFFSET + TIMER_STATUS_REG:
+            sim_clear_bits(offset, value);  // Write 1 to clear
+            break;
+        
+        case ADC_BASE_OFFSET + ADC_CONTROL_REG:
+            sim_set_reg(offset, value & ~ADC_CONTROL_START);
+            if ((value & ADC_CONTROL_ENABLE) && (value & ADC_CONTROL_START)) {
+                uint32_t channel = (value >> ADC_CONTROL_CHANNEL_SHIFT) % ADC_CHANNEL_COUNT;
+                sim_clear_bits(ADC_BASE_OFFSET + ADC_STATUS_REG, ADC_STATUS_DONE);
+                sim_cancel(SIM_EVENT_ADC_DONE);  // A new start restarts the conversion
+                sim_schedule(sim.now_ns + HAL_SIM_ADC_CONVERSION_NS, SIM_EVENT_ADC_DONE, channel);
+            }
+            break;
+        
+        default:
+            sim_set_reg(offset, value);
+            break;
+    }
+}
+
+uint32_t hal_sim_read(uint32_t addr) {
+    uint32_t offset = addr - FPGA_BASE_ADDR;
+    if (offset >= FPGA_WINDOW_SIZE) return 0;  // Unmapped reads as zero
+    
+    sim_acquire();
+    uint32_t value = sim_read(offset);
+    sim_release();
+    return value;
+}
+
+void hal_sim_write(uint32_t addr, uint32_t value) {
+    uint32_t offset = addr - FPGA_BASE_ADDR;
+    if (offset >= FPGA_WINDOW_SIZE) return;    // Unmapped writes are dropped
+    
+    sim_acquire();
+    sim_write(offset, value);
+    sim_release();
+}
+
+// Simulator control
+uint64_t hal_sim_time_ns(void) {
+    sim_acquire();
+    uint64_t now = sim.now_ns;
+    sim_release();
+    return now;
+}
+
+void hal_sim_advance_ns(uint64_t ns) {
+    sim_acquire();
+    sim_run_until(sim.now_ns + ns);
+    sim_release();
+}
+
+int hal_sim_run_next_event(void) {
+    sim_acquire();
+    while (sim.event_count > 0 && sim_pace(sim.events[0].time_ns)) {
+    }
+    int ran = sim.event_count > 0;
+    if (ran) {
+        sim_event_t event = sim_pop();
+        sim_run_event(&event);
+    }
+    sim_release();
+    return ran;
+}
+
+int hal_sim_set_realtime(int enable) {
+    sim_acquire();
+    int result = sim_set_realtime(enable);
+    sim_release();
+    return result;
+}
+
+void hal_sim_adc_set_source(hal_sim_adc_source_t source, void* context) {
+    sim_acquire();
+    sim.adc_source = source;
+    sim.adc_context = context;
+    sim_release();
+}
+
+void hal_sim_adc_set_level(uint32_t channel, uint16_t level) {
+    sim_acquire();
+    if (!sim.initialized) sim_init_defaults();
+    if (channel < ADC_CHANNEL_COUNT) {
+        sim.adc_level[channel] = level & 0x0FFF;
+    }
+    sim_release();
+}
+
+void hal_sim_clock_set(uint32_t pin, uint64_t millihertz) {
+    if (pin > GPIO_EDGE_PIN_MASK) return;
+    
+    sim_acquire();
+    sim_edge_rebase();
+    sim.clock_millihertz[pin] = millihertz;
+    sim_release();
+}
+
+int hal_sim_uart_inject_rx(const char* data, uint32_t length) {
+    sim_acquire();
+    if (length > SIM_UART_LINE_SIZE - sim.uart_line_count) {
+        sim_release();
+        return -1;
+    }
+    
+    // An idle line starts a new RX event; a busy one already has it queued
+    if (sim.uart_line_count == 0 && length > 0) {
+        sim_schedule(sim.now_ns + sim_uart_char_ns(), SIM_EVENT_UART_RX_BYTE, 0);
+    }
+    for (uint32_t i = 0; i < length; i++) {
+        sim.uart_line[(sim.uart_line_head + sim.uart_line_count) % SIM_UART_LINE_SIZE] = data[i];
+        sim.uart_line_count++;
+    }
+    sim_release();
+    return 0;
+}
+
+uint32_t hal_sim_uart_take_tx(char* buffer, uint32_t max_length) {
+    sim_acquire();
+    uint32_t taken = 0;
+    while (taken < max_length && sim.uart_tx_count > 0) {
+        buffer[taken++] = sim.uart_tx[sim.uart_tx_head];
+        sim.uart_tx_head = (sim.uart_tx_head + 1) % SIM_UART_FIFO_SIZE;
+        sim.uart_tx_count--;
+    }
+    sim_release();
+    return taken;
+}
+
+uint32_t hal_sim_uart_tx_count(void) {
+    return sim.uart_tx_total;
+}
+
+const hal_backend_t hal_backend_sim = {
+    "sim",
+    NULL,
+    hal_sim_read,
+    hal_sim_write
+};
@@ -0,0 +1,52 @@
+#ifndef HAL_SIM_H
+#define HAL_SIM_H
+
+#include <stdint.h>
+
+// Discrete-event peripheral simulator behind the sim, record and mapped
+// backends. Peripherals schedule events on a virtual clock; every register
+// access costs a little virtual bus time, and polling a status register
+// whose bit is still clear advances the clock straight to that peripheral's
+// next event. A poll loop therefore ends after a few iterations, with the
+// virtual clock showing the time real hardware would have taken.
+//
+// Virtual time and the event queue are per process, even when the register
+// window is shared, so only one process may drive the peripherals of a
+// shared window; the mapped backends refuse a second driver.
+
+// Simulated timings
+#define HAL_SIM_BUS_ACCESS_NS      10u     // Cost of one register access
+#define HAL_SIM_ADC_CONVERSION_NS  5000u   // 200 kSPS SAR converter
+#define HAL_SIM_UART_DEFAULT_BAUD  115200u
+#define HAL_SIM_REALTIME_SLICE_NS  100000u  // Pacing granularity in real-time mode
+
+// Virtual clock
+uint64_t hal_sim_time_ns(void);
+void hal_sim_advance_ns(uint64_t ns);     // Run all events due within ns
+int hal_sim_run_next_event(void);         // Returns 0 if nothing was pending
+
+// Real-time mode (host only, or FPGA_HAL_SIM_REALTIME=1): the virtual clock
+// is held to the wall clock with absolute clock_nanosleep() waits, so delays
+// take real time without spinning - useful when watching a shared board.
+int hal_sim_set_realtime(int enable);
+
+// ADC input model. The default source gives each channel a fixed level
+// (about 1.0 V + 0.25 V per channel) with a few LSB of deterministic noise.
+typedef uint16_t (*hal_sim_adc_source_t)(uint32_t channel, uint64_t time_ns, void* context);
+void hal_sim_adc_set_source(hal_sim_adc_source_t source, void* context);
+void hal_sim_adc_set_level(uint32_t channel, uint16_t level);
+
+// Clock sources on the GPIO inputs, as seen by the edge counter
+// (GPIO_EDGE_*). Millihertz so sub-hertz references can be modelled and
+// 64 bits so multi-GHz clocks fit; 0 stops the clock. Edges are derived from
+// the virtual clock, so any frequency costs the same to simulate.
+void hal_sim_clock_set(uint32_t pin, uint64_t millihertz);
+
+// UART line model. Injected bytes arrive one character time apart after
+// those already on the line; up to 4096 may be in flight. Returns -1, and
+// injects nothing, if the bytes do not fit.
+int hal_sim_uart_inject_rx(const char* data, uint32_t length);
+uint32_t hal_sim_uart_take_tx(char* buffer, uint32_t max_length);
+uint32_t hal_sim_uart_tx_count(void);
+
+#endif // HAL_SIM_H
@@ -0,0 +1,88 @@
+#include "fpga_hal.h"
+#include "fpga_hal_regs.h"
+#include "hal_backend.h"
+
+// 64-bit timebase on top of the 32-bit, 1 MHz hardware timer.
+//
+// The high word is extended in software: a reading lower than the previous
+// one means the counter wrapped. Waits use the compare-match flag in chunks
+// of at most 2^31 ticks, re-reading the 64-bit count between chunks, so
+// arbitrarily long delays stay exact across wraparound. On the host the
+// simulated timer runs on virtual time; see hal_sim_set_realtime() for
+// wall-clock paced runs that sleep instead of spinning.
+
+#define REG_WRITE(addr, val) hal_reg_write((addr), (val))
+#define REG_READ(addr) hal_reg_read(addr)
+
+#define TIMER_TICKS_PER_US (TIMER_FREQUENCY_HZ / 1000000u)
+#define TIMEBASE_MAX_CHUNK 0x7FFFFFFFu
+#define TIMEBASE_SPIN_TICKS 16u  // Shorter waits poll the count directly
+
+static uint32_t timebase_last;
+static uint32_t timebase_high;
+
+void hal_timebase_reset(void) {
+    timebase_last = hal_timer_get_count();
+    timebase_high = 0;
+}
+
+uint64_t hal_timer_get_count64(void) {
+    uint32_t now = hal_timer_get_count();
+    if (now < timebase_last) {
+        timebase_high++;
+    }
+    timebase_last = now;
+    return ((uint64_t)timebase_high << 32) | now;
+}
+
+static void timebase_wait_until(uint64_t target) {
+    uint32_t timer_base = FPGA_BASE_ADDR + TIMER_BASE_OFFSET;
+    if (!(REG_READ(timer_base + TIMER_CONTROL_REG) & TIMER_CONTROL_ENABLE)) {
+        REG_WRITE(timer_base + TIMER_CONTROL_REG, TIMER_CONTROL_ENABLE);
+    }
+    
+    for (;;) {
+        uint64_t now = hal_timer_get_count64();
+        if (now >= target) return;
+        
+        uint64_t remaining = target - now;
+        if (remaining < TIMEBASE_SPIN_TICKS) continue;
+        
+        uint32_t chunk = remaining > TIMEBASE_MAX_CHUNK ? TIMEBASE_MAX_CHUNK : (uint32_t)remaining;
+        REG_WRITE(timer_base + TIMER_COMPARE_REG, (uint32_t)now + chunk);
+        REG_WRITE(timer_base + TIMER_STATUS_REG, TIMER_STATUS_MATCH);  // Drop any stale match
+        
+        while (!(REG_READ(timer_base + TIMER_STATUS_REG) & TIMER_STATUS_MATCH));
+    }
+}
+
+void hal_delay_us(uint32_t us) {
+    if (us == 0) return;
+    timebase_wait_until(hal_timer_get_count64() + (uint64_t)us * TIMER_TICKS_PER_US);
+}
+
+void hal_delay_ms(uint32_t ms) {
+    if (ms == 0) return;
+    timebase_wait_until(hal_timer_get_count64() + (uint64_t)ms * 1000u * TIMER_TICKS_PER_US);
+}
+
+void hal_deadline_set_us(hal_deadline_t* deadline, uint64_t us) {
+    deadline->expiry = hal_timer_get_count64() + us * TIMER_TICKS_PER_US;
+}
+
+void hal_deadline_set_ms(hal_deadline_t* deadline, uint64_t ms) {
+    hal_deadline_set_us(deadline, ms * 1000u);
+}
+
+int hal_deadline_expired(const hal_deadline_t* deadline) {
+    return hal_timer_get_count64() >= deadline->expiry;
+}
+
+uint64_t hal_deadline_remaining_us(const hal_deadline_t* deadline) {
+    uint64_t now = hal_timer_get_count64();
+    return now >= deadline->expiry ? 0 : (deadline->expiry - now) / TIMER_TICKS_PER_US;
+}
+
+void hal_deadline_wait(const hal_deadline_t* deadline) {
+    timebase_wait_until(deadline->expiry);
+}
@@ -0,0 +1,99 @@
+#include "fpga_hal.h"
+#include "fpga_hal_regs.h"
+#include "hal_backend.h"
+
+// Buffered, non-blocking UART transmit path.
+//
+// hal_uart_write() copies into a software ring and returns at once; whatever
+// does not fit is dropped and counted. hal_uart_tx_drain() moves bytes into
+// the hardware TX FIFO for as long as it has room, so one call pushes a
+// burst of up to UART_TX_FIFO_DEPTH bytes. Call it from the main loop or the
+// UART TX-ready interrupt. The writer and the drainer may run in different
+// contexts: head and tail are free-running counters with acquire/release
+// ordering, one owned by each side.
+
+#define REG_WRITE(addr, val) hal_reg_write((addr), (val))
+#define REG_READ(addr) hal_reg_read(addr)
+
+#define UART_TX_RING_MASK (HAL_UART_TX_BUFFER_SIZE - 1)
+
+#if (HAL_UART_TX_BUFFER_SIZE & UART_TX_RING_MASK) != 0
+#error "HAL_UART_TX_BUFFER_SIZE must be a power of two"
+#endif
+
+typedef struct {
+    uint8_t ring[HAL_UART_TX_BUFFER_SIZE];
+    uint32_t head;      // Bytes written (writer)
+    uint32_t tail;      // Bytes drained (drainer)
+    uint32_t queued;
+    uint32_t dropped;
+} uart_tx_t;
+
+static uart_tx_t uart_tx;
+
+uint32_t hal_uart_write(const void* data, uint32_t length) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t head = uart_tx.head;
+    uint32_t tail = __atomic_load_n(&uart_tx.tail, __ATOMIC_ACQUIRE);
+    uint32_t space = HAL_UART_TX_BUFFER_SIZE - (head - tail);
+    uint32_t accepted = (length < space) ? length : space;
+    
+    for (uint32_t i = 0; i < accepted; i++) {
+        uart_tx.ring[(head + i) & UART_TX_RING_MASK] = bytes[i];
+    }
+    __atomic_store_n(&uart_tx.head, head + accepted, __ATOMIC_RELEASE);
+    
+    uart_tx.queued += accepted;
+    uart_tx.dropped += length - accepted;
+    return accepted;
+}
+
+uint32_t hal_uart_tx_drain(void) {
+    uint32_t uart_base = FPGA_BASE_ADDR + UART_BASE_OFFSET;
+    uint32_t head = __atomic_load_n(&uart_tx.head, __ATOMIC_ACQUIRE);
+    uint32_t tail = uart_tx.tail;
+    uint32_t moved = 0;
+    
+    while (tail != head && (REG_READ(uart_base + UART_STATUS_REG) & UART_STATUS_TX_READY)) {
+        REG_WRITE(uart_base + UART_DATA_REG, uart_tx.ring[tail & UART_TX_RING_MASK]);
+        tail++;
+        moved++;
+    }
+    
+    __atomic_store_n(&uart_tx.tail, tail, __ATOMIC_RELEASE);
+    return moved;
+}
+
+uint32_t hal_uart_tx_pending(void) {
+    return __atomic_load_n(&uart_tx.head, __ATOMIC_ACQUIRE) -
+           __atomic_load_n(&uart_tx.tail, __ATOMIC_ACQUIRE);
+}
+
+// Drains until the ring and the hardware FIFO are empty. Returns 0 when
+// everything has left the wire, -1 if timeout_ms timer milliseconds pass first.
+int hal_uart_flush(uint32_t timeout_ms) {
+    uint32_t uart_base = FPGA_BASE_ADDR + UART_BASE_OFFSET;
+    hal_deadline_t deadline;
+    hal_deadline_set_ms(&deadline, timeout_ms);
+    
+    for (;;) {
+        hal_uart_tx_drain();
+        
+        if (hal_uart_tx_pending() == 0 &&
+            (REG_READ(uart_base + UART_STATUS_REG) & UART_STATUS_TX_EMPTY)) {
+            return 0;
+        }
+        
+        if (hal_deadline_expired(&deadline)) {
+            return -1;
+        }
+    }
+}
+
+void hal_uart_tx_get_stats(hal_uart_tx_stats_t* stats) {
+    if (!stats) return;
+    
+    stats->bytes_queued = uart_tx.queued;
+    stats->bytes_dropped = uart_tx.dropped;
+    stats->bytes_drained = __atomic_load_n(&uart_tx.tail, __ATOMIC_ACQUIRE);
+}
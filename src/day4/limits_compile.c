@@ -0,0 +1,273 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "limits_table.h"
+
+// Compiles a limits spec sheet into the binary table read by limits_open().
+//
+//   limits_compile [--revision=N] spec.csv limits.bin
+//
+// CSV columns: test_id,expected,lo,hi[,units]. Blank lines, lines starting
+// with '#', and a header line whose first field is "test_id" are skipped.
+
+#define LIMITS_LINE_MAX 512
+
+typedef struct {
+    char* test_id;
+    char* units;
+    double expected;
+    double lo;
+    double hi;
+} spec_row_t;
+
+static char* trim(char* text) {
+    while (isspace((unsigned char)*text)) {
+        text++;
+    }
+    char* end = text + strlen(text);
+    while (end > text && isspace((unsigned char)end[-1])) {
+        *--end = '\0';
+    }
+    return text;
+}
+
+static char* dup_string(const char* text) {
+    char* copy = malloc(strlen(text) + 1);
+    if (copy) {
+        strcpy(copy, text);
+    }
+    return copy;
+}
+
+static int parse_number(const char* field, double* out) {
+    char* end;
+    *out = strtod(field, &end);
+    return end != field && *trim(end) == '\0';
+}
+
+// Splits line in place; returns the number of fields
+static int split_fields(char* line, char* fields[], int max_fields) {
+    int count = 0;
+    char* cursor = line;
+    
+    while (count < max_fields) {
+        char* comma = strchr(cursor, ',');
+        if (comma) {
+            *comma = '\0';
+        }
+        fields[count++] = trim(cursor);
+        if (!comma) {
+            break;
+        }
+        cursor = comma + 1;
+    }
+    return count;
+}
+
+static int load_spec(const char* path, spec_row_t** rows_out, uint32_t* count_out) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        perror(path);
+        return -1;
+    }
+    
+    spec_row_t* rows = NULL;
+    uint32_t count = 0;
+    uint32_t capacity = 0;
+    char line[LIMITS_LINE_MAX];
+    int line_number = 0;
+    int status = 0;
+    
+    while (fgets(line, sizeof(line), file)) {
+        line_number++;
+        char* text = trim(line);
+        if (*text == '\0' || *text == '#') {
+            continue;
+        }
+        
+        char* fields[6];
+        int field_count = split_fields(text, fields, 6);
+        if (strcmp(fields[0], "test_id") == 0) {
+            continue;
+        }
+        
+        spec_row_t row;
+        if (field_count < 4 || field_count > 5 || *fields[0] == '\0' ||
+            !parse_number(fields[1], &row.expected) ||
+            !parse_number(fields[2], &row.lo) || !parse_number(fields[3], &row.hi)) {
+            fprintf(stderr, "%s:%d: expected test_id,expected,lo,hi[,units]\n", path, line_number);
+            status = -1;
+            break;
+        }
+        if (row.lo > row.hi) {
+            fprintf(stderr, "%s:%d: %s has lo > hi\n", path, line_number, fields[0]);
+            status = -1;
+            break;
+        }
+        
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            spec_row_t* grown = realloc(rows, capacity * sizeof(*rows));
+            if (!grown) {
+                fprintf(stderr, "%s: out of memory\n", path);
+                status = -1;
+                break;
+            }
+            rows = grown;
+        }
+        
+        row.test_id = dup_string(fields[0]);
+        row.units = dup_string(field_count == 5 ? fields[4] : "");
+        if (!row.test_id || !row.units) {
+            free(row.test_id);
+            free(row.units);
+            fprintf(stderr, "%s: out of memory\n", path);
+            status = -1;
+            break;
+        }
+        rows[count++] = row;
+    }
+    
+    fclose(file);
+    *rows_out = rows;
+    *count_out = count;
+    return status;
+}
+
+static uint32_t align_up(uint32_t value, uint32_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static int write_table(const char* path, const spec_row_t* rows, uint32_t count,
+                       uint32_t revision) {
+    uint32_t bucket_count = 16;
+    while (bucket_count < count * 2) {
+        bucket_count *= 2;
+    }
+    
+    uint32_t strings_size = 1;  // Offset 0 is the empty string
+    for (uint32_t i = 0; i < count; i++) {
+        strings_size += (uint32_t)strlen(rows[i].test_id) + 1;
+        strings_size += (uint32_t)strlen(rows[i].units) + 1;
+    }
+    
+    limits_file_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = LIMITS_MAGIC;
+    header.version = LIMITS_VERSION;
+    header.revision = revision;
+    header.entry_count = count;
+    header.bucket_count = bucket_count;
+    header.entries_offset = align_up(sizeof(header), 8);
+    header.index_offset = header.entries_offset + count * (uint32_t)sizeof(limits_file_entry_t);
+    header.strings_offset = header.index_offset + bucket_count * (uint32_t)sizeof(uint32_t);
+    header.strings_size = strings_size;
+    
+    uint32_t image_size = header.strings_offset + strings_size;
+    uint8_t* image = calloc(1, image_size);
+    if (!image) {
+        fprintf(stderr, "%s: out of memory\n", path);
+        return -1;
+    }
+    
+    memcpy(image, &header, sizeof(header));
+    limits_file_entry_t* entries = (limits_file_entry_t*)(image + header.entries_offset);
+    uint32_t* index = (uint32_t*)(image + header.index_offset);
+    char* strings = (char*)(image + header.strings_offset);
+    uint32_t string_cursor = 1;
+    int status = 0;
+    
+    for (uint32_t i = 0; i < count && status == 0; i++) {
+        limits_file_entry_t* entry = &entries[i];
+        entry->expected = rows[i].expected;
+        entry->lo = rows[i].lo;
+        entry->hi = rows[i].hi;
+        entry->hash = limits_hash(rows[i].test_id);
+        
+        entry->id_offset = string_cursor;
+        strcpy(strings + string_cursor, rows[i].test_id);
+        string_cursor += (uint32_t)strlen(rows[i].test_id) + 1;
+        
+        entry->units_offset = 0;
+        if (rows[i].units[0] != '\0') {
+            entry->units_offset = string_cursor;
+            strcpy(strings + string_cursor, rows[i].units);
+            string_cursor += (uint32_t)strlen(rows[i].units) + 1;
+        }
+        
+        uint32_t slot = entry->hash & (bucket_count - 1);
+        while (index[slot] != 0) {
+            const limits_file_entry_t* other = &entries[index[slot] - 1];
+            if (other->hash == entry->hash &&
+                strcmp(strings + other->id_offset, rows[i].test_id) == 0) {
+                fprintf(stderr, "duplicate test_id: %s\n", rows[i].test_id);
+                status = -1;
+                break;
+            }
+            slot = (slot + 1) & (bucket_count - 1);
+        }
+        index[slot] = i + 1;
+    }
+    
+    if (status == 0) {
+        FILE* file = fopen(path, "wb");
+        if (!file) {
+            perror(path);
+            status = -1;
+        } else {
+            if (fwrite(image, 1, image_size, file) != image_size) {
+                perror(path);
+                status = -1;
+            }
+            if (fclose(file) != 0) {
+                status = -1;
+            }
+        }
+    }
+    
+    free(image);
+    return status;
+}
+
+int main(int argc, char* argv[]) {
+    const char* input = NULL;
+    const char* output = NULL;
+    uint32_t revision = 0;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--revision=", 11) == 0) {
+            revision = (uint32_t)strtoul(argv[i] + 11, NULL, 0);
+        } else if (!input) {
+            input = argv[i];
+        } else if (!output) {
+            output = argv[i];
+        } else {
+            input = NULL;
+            break;
+        }
+    }
+    if (!input || !output) {
+        fprintf(stderr, "usage: %s [--revision=N] spec.csv limits.bin\n", argv[0]);
+        return 1;
+    }
+    
+    spec_row_t* rows = NULL;
+    uint32_t count = 0;
+    int status = load_spec(input, &rows, &count);
+    if (status == 0) {
+        status = write_table(output, rows, count, revision);
+    }
+    
+    for (uint32_t i = 0; i < count; i++) {
+        free(rows[i].test_id);
+        free(rows[i].units);
+    }
+    free(rows);
+    
+    if (status != 0) {
+        return 1;
+    }
+    printf("%s: %u limits, revision %u -> %s\n", input, (unsigned)count, (unsigned)revision, output);
+    return 0;
+}
@@ -0,0 +1,216 @@
+#define _POSIX_C_SOURCE 200112L
+#include "limits_table.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef __riscv
+#define LIMITS_HAVE_MMAP 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#endif
+
+static const uint8_t* limits_image = NULL;
+static size_t limits_image_size = 0;
+static int limits_image_mapped = 0;
+#if LIMITS_HAVE_MMAP
+static pthread_once_t limits_env_once = PTHREAD_ONCE_INIT;
+#else
+static int limits_env_tried = 0;    // Single core, no threads on the target
+#endif
+
+// FNV-1a
+uint32_t limits_hash(const char* test_id) {
+    uint32_t hash = 2166136261u;
+    while (*test_id) {
+        hash ^= (uint8_t)*test_id++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static const limits_file_header_t* limits_header(void) {
+    return (const limits_file_header_t*)limits_image;
+}
+
+static int limits_string_ok(const uint8_t* image, uint32_t offset) {
+    const limits_file_header_t* header = (const limits_file_header_t*)image;
+    return offset < header->strings_size &&
+           memchr(image + header->strings_offset + offset, '\0',
+                  header->strings_size - offset) != NULL;
+}
+
+// Reject anything whose offsets would read outside the image
+static int limits_validate(const uint8_t* image, size_t size) {
+    const limits_file_header_t* header = (const limits_file_header_t*)image;
+    
+    if (size < sizeof(*header) || header->magic != LIMITS_MAGIC) {
+        fprintf(stderr, "limits: not a compiled limits table\n");
+        return -1;
+    }
+    if (header->version != LIMITS_VERSION) {
+        fprintf(stderr, "limits: table version %u, expected %u\n",
+                (unsigned)header->version, (unsigned)LIMITS_VERSION);
+        return -1;
+    }
+    
+    uint64_t entries_end = (uint64_t)header->entries_offset +
+                           (uint64_t)header->entry_count * sizeof(limits_file_entry_t);
+    uint64_t index_end = (uint64_t)header->index_offset +
+                         (uint64_t)header->bucket_count * sizeof(uint32_t);
+    uint64_t strings_end = (uint64_t)header->strings_offset + header->strings_size;
+    
+    if (header->bucket_count == 0 || (header->bucket_count & (header->bucket_count - 1)) != 0 ||
+        header->bucket_count < header->entry_count * 2u ||
+        (header->entries_offset % sizeof(double)) != 0 || (header->index_offset % 4) != 0 ||
+        entries_end > size || index_end > size || strings_end > size) {
+        fprintf(stderr, "limits: corrupt table layout\n");
+        return -1;
+    }
+    
+    const limits_file_entry_t* entries =
+        (const limits_file_entry_t*)(image + header->entries_offset);
+    const uint32_t* index = (const uint32_t*)(image + header->index_offset);
+    int ok = 1;
+    for (uint32_t i = 0; i < header->entry_count && ok; i++) {
+        ok = limits_string_ok(image, entries[i].id_offset) &&
+             limits_string_ok(image, entries[i].units_offset);
+    }
+    for (uint32_t i = 0; i < header->bucket_count && ok; i++) {
+        ok = index[i] <= header->entry_count;
+    }
+    
+    if (!ok) {
+        fprintf(stderr, "limits: corrupt table entries\n");
+        return -1;
+    }
+    return 0;
+}
+
+int limits_open_image(const void* image, size_t size) {
+    if (limits_validate((const uint8_t*)image, size) != 0) {
+        return -1;
+    }
+    
+    limits_close();
+    limits_image = (const uint8_t*)image;
+    limits_image_size = size;
+    return 0;
+}
+
+int limits_open(const char* path) {
+#if LIMITS_HAVE_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return -1;
+    }
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        fprintf(stderr, "limits: %s is empty\n", path);
+        close(fd);
+        return -1;
+    }
+    
+    void* image = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (image == MAP_FAILED) {
+        perror(path);
+        return -1;
+    }
+    
+    if (limits_open_image(image, (size_t)st.st_size) != 0) {
+        munmap(image, (size_t)st.st_size);
+        return -1;
+    }
+    limits_image_mapped = 1;
+    return 0;
+#else
+    fprintf(stderr, "limits: no filesystem on this target, use limits_open_image() for %s\n", path);
+    return -1;
+#endif
+}
+
+void limits_close(void) {
+#if LIMITS_HAVE_MMAP
+    if (limits_image && limits_image_mapped) {
+        munmap((void*)limits_image, limits_image_size);
+    }
+#endif
+    limits_image = NULL;
+    limits_image_size = 0;
+    limits_image_mapped = 0;
+}
+
+static void limits_open_env_file(void) {
+    const char* path = getenv("VALIDATION_LIMITS_FILE");
+    if (!limits_image && path && *path) {
+        limits_open(path);
+    }
+}
+
+// Once only: concurrent first lookups must not both map the file, nor one
+// replace (and unmap) the image while another is reading it
+static void limits_open_from_env(void) {
+#if LIMITS_HAVE_MMAP
+    pthread_once(&limits_env_once, limits_open_env_file);
+#else
+    if (!limits_env_tried) {
+        limits_env_tried = 1;
+        limits_open_env_file();
+    }
+#endif
+}
+
+bool limits_lookup(const char* test_id, limits_t* out) {
+    limits_open_from_env();
+    if (!limits_image) {
+        return false;
+    }
+    
+    const limits_file_header_t* header = limits_header();
+    const limits_file_entry_t* entries =
+        (const limits_file_entry_t*)(limits_image + header->entries_offset);
+    const uint32_t* index = (const uint32_t*)(limits_image + header->index_offset);
+    const char* strings = (const char*)(limits_image + header->strings_offset);
+    uint32_t hash = limits_hash(test_id);
+    uint32_t mask = header->bucket_count - 1;
+    
+    // Linear probing; the index is at most half full, so an empty bucket ends it
+    for (uint32_t probe = 0; probe < header->bucket_count; probe++) {
+        uint32_t slot = index[(hash + probe) & mask];
+        if (slot == 0) {
+            return false;
+        }
+        
+        const limits_file_entry_t* entry = &entries[slot - 1];
+        if (entry->hash == hash && strcmp(strings + entry->id_offset, test_id) == 0) {
+            if (out) {
+                out->test_id = strings + entry->id_offset;
+                out->expected = entry->expected;
+                out->lo = entry->lo;
+                out->hi = entry->hi;
+                out->units = strings + entry->units_offset;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool limits_loaded(void) {
+    limits_open_from_env();
+    return limits_image != NULL;
+}
+
+uint32_t limits_count(void) {
+    return limits_loaded() ? limits_header()->entry_count : 0;
+}
+
+uint32_t limits_revision(void) {
+    return limits_loaded() ? limits_header()->revision : 0;
+}
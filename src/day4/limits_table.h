@@ -0,0 +1,65 @@
+#ifndef LIMITS_TABLE_H
+#define LIMITS_TABLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Compiled limits tables: a spec sheet (CSV) is turned into a packed binary
+// by limits_compile and mapped read-only at startup, so a new limits
+// revision needs no rebuild and loading costs one mmap instead of parsing.
+// Lookups go through an open-addressed hash index: O(1) per test ID.
+
+typedef struct {
+    const char* test_id;
+    double expected;
+    double lo;                  // Inclusive
+    double hi;                  // Inclusive
+    const char* units;
+} limits_t;
+
+// Load a compiled table from a file (mmap) or from an image already in
+// memory, e.g. linked into flash on the target. Replaces any loaded table.
+// Not synchronized against concurrent lookups.
+int limits_open(const char* path);
+int limits_open_image(const void* image, size_t size);
+void limits_close(void);
+
+// Without an explicit open, the first lookup loads $VALIDATION_LIMITS_FILE
+// (exactly once, safe from concurrent first lookups)
+bool limits_lookup(const char* test_id, limits_t* out);
+bool limits_loaded(void);
+uint32_t limits_count(void);
+uint32_t limits_revision(void);
+
+// Binary format, shared with limits_compile. All offsets are from the start
+// of the image; strings are NUL-terminated in the string area.
+#define LIMITS_MAGIC   0x544D494Cu  // "LIMT"
+#define LIMITS_VERSION 1
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t revision;
+    uint32_t entry_count;
+    uint32_t bucket_count;      // Power of two, at least twice entry_count
+    uint32_t entries_offset;
+    uint32_t index_offset;      // bucket_count x uint32: entry index + 1, 0 = empty
+    uint32_t strings_offset;
+    uint32_t strings_size;
+    uint32_t reserved;
+} limits_file_header_t;
+
+typedef struct {
+    double expected;
+    double lo;
+    double hi;
+    uint32_t hash;
+    uint32_t id_offset;
+    uint32_t units_offset;
+    uint32_t reserved;
+} limits_file_entry_t;
+
+uint32_t limits_hash(const char* test_id);
+
+#endif // LIMITS_TABLE_H
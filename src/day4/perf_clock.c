@@ -0,0 +1,85 @@
+#define _GNU_SOURCE
+#include "perf_clock.h"
+
+#ifndef __riscv
+#include <time.h>
+#endif
+
+#define PERF_CALIBRATION_ROUNDS 1000
+
+static perf_ticks_t perf_overhead = 0;
+static int perf_calibrated = 0;
+
+#ifdef __riscv
+
+// The high half is read twice so a carry between the two reads is caught
+perf_ticks_t perf_clock_now(void) {
+    uint32_t high, low, high_again;
+    do {
+        __asm__ volatile ("rdcycleh %0" : "=r"(high));
+        __asm__ volatile ("rdcycle %0" : "=r"(low));
+        __asm__ volatile ("rdcycleh %0" : "=r"(high_again));
+    } while (high != high_again);
+    
+    return ((uint64_t)high << 32) | low;
+}
+
+uint64_t perf_clock_to_ns(perf_ticks_t ticks) {
+    // Split to keep ticks * 1e9 from overflowing on long intervals
+    return (ticks / PERF_CPU_HZ) * 1000000000ull +
+           ((ticks % PERF_CPU_HZ) * 1000000000ull) / PERF_CPU_HZ;
+}
+
+const char* perf_clock_source(void) {
+    return "rdcycle";
+}
+
+#else
+
+#ifdef CLOCK_MONOTONIC_RAW
+#define PERF_CLOCK_ID CLOCK_MONOTONIC_RAW
+#define PERF_CLOCK_NAME "CLOCK_MONOTONIC_RAW"
+#else
+#define PERF_CLOCK_ID CLOCK_MONOTONIC
+#define PERF_CLOCK_NAME "CLOCK_MONOTONIC"
+#endif
+
+perf_ticks_t perf_clock_now(void) {
+    struct timespec ts;
+    clock_gettime(PERF_CLOCK_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t perf_clock_to_ns(perf_ticks_t ticks) {
+    return ticks;
+}
+
+const char* perf_clock_source(void) {
+    return PERF_CLOCK_NAME;
+}
+
+#endif
+
+// The minimum over many back-to-back pairs is the fixed cost of one
+// measurement; anything above it is scheduling or cache noise
+void perf_clock_calibrate(void) {
+    perf_ticks_t best = UINT64_MAX;
+    
+    for (int i = 0; i < PERF_CALIBRATION_ROUNDS; i++) {
+        perf_ticks_t start = perf_clock_now();
+        perf_ticks_t end = perf_clock_now();
+        if (end - start < best) {
+            best = end - start;
+        }
+    }
+    
+    perf_overhead = best;
+    perf_calibrated = 1;
+}
+
+perf_ticks_t perf_clock_overhead(void) {
+    if (!perf_calibrated) {
+        perf_clock_calibrate();
+    }
+    return perf_overhead;
+}
@@ -0,0 +1,25 @@
+#ifndef PERF_CLOCK_H
+#define PERF_CLOCK_H
+
+#include <stdint.h>
+
+// Profiling clock for cycle-accurate measurements.
+//   RV32:   rdcycle/rdcycleh (64-bit cycle CSR), converted with PERF_CPU_HZ
+//   Native: clock_gettime(CLOCK_MONOTONIC_RAW), already in nanoseconds
+// Both return raw ticks; convert with perf_clock_to_ns(). The cost of
+// reading the clock is measured once by perf_clock_calibrate() and can be
+// subtracted from short intervals.
+
+#ifndef PERF_CPU_HZ
+#define PERF_CPU_HZ 100000000u  // MicroBlaze-V core clock on the reference board
+#endif
+
+typedef uint64_t perf_ticks_t;
+
+perf_ticks_t perf_clock_now(void);
+uint64_t perf_clock_to_ns(perf_ticks_t ticks);
+void perf_clock_calibrate(void);
+perf_ticks_t perf_clock_overhead(void);   // Ticks per back-to-back read pair
+const char* perf_clock_source(void);
+
+#endif // PERF_CLOCK_H
@@ -0,0 +1,338 @@
+#include <math.h>
+#include "power_analyzer.h"
+
+// Samples are processed in chunks: a vector kernel forms the chunk's power
+// samples with their sums and maximum, then one scalar pass slides the
+// window and runs the limit state machines over the chunk. The kernel is
+// picked at first use like the batch validators: AVX2 or SSE2 on x86-64,
+// scalar elsewhere. Vector lanes sum a chunk in float and fold it into the
+// double totals, so results match the scalar path to float rounding.
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define POWER_ANALYZER_X86 1
+#include <immintrin.h>
+#endif
+
+#define POWER_CHUNK 256
+
+typedef struct {
+    double sum_p;
+    double sum_v2;
+    double sum_i2;
+    float max_p;
+} power_chunk_t;
+
+typedef void (*power_chunk_fn)(const float*, const float*, size_t, float*, power_chunk_t*);
+
+static void power_chunk_tail(const float* voltage, const float* current, size_t start, size_t n,
+                             float* power, power_chunk_t* acc) {
+    for (size_t k = start; k < n; k++) {
+        float p = voltage[k] * current[k];
+        power[k] = p;
+        acc->sum_p += p;
+        acc->sum_v2 += (double)voltage[k] * voltage[k];
+        acc->sum_i2 += (double)current[k] * current[k];
+        if (p > acc->max_p) acc->max_p = p;
+    }
+}
+
+static void power_chunk_scalar(const float* voltage, const float* current, size_t n,
+                               float* power, power_chunk_t* acc) {
+    power_chunk_tail(voltage, current, 0, n, power, acc);
+}
+
+#ifdef POWER_ANALYZER_X86
+
+static float hsum_ps_sse2(__m128 v) {
+    __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    return _mm_cvtss_f32(_mm_add_ss(sums, shuf));
+}
+
+static float hmax_ps_sse2(__m128 v) {
+    __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 maxs = _mm_max_ps(v, shuf);
+    shuf = _mm_movehl_ps(shuf, maxs);
+    return _mm_cvtss_f32(_mm_max_ss(maxs, shuf));
+}
+
+static void power_chunk_sse2(const float* voltage, const float* current, size_t n,
+                             float* power, power_chunk_t* acc) {
+    __m128 sum_p = _mm_setzero_ps();
+    __m128 sum_v2 = _mm_setzero_ps();
+    __m128 sum_i2 = _mm_setzero_ps();
+    __m128 max_p = _mm_set1_ps(acc->max_p);
+    size_t k = 0;
+    
+    for (; k + 4 <= n; k += 4) {
+        __m128 v = _mm_loadu_ps(voltage + k);
+        __m128 i = _mm_loadu_ps(current + k);
+        __m128 p = _mm_mul_ps(v, i);
+        _mm_storeu_ps(power + k, p);
+        sum_p = _mm_add_ps(sum_p, p);
+        sum_v2 = _mm_add_ps(sum_v2, _mm_mul_ps(v, v));
+        sum_i2 = _mm_add_ps(sum_i2, _mm_mul_ps(i, i));
+        max_p = _mm_max_ps(max_p, p);
+    }
+    
+    acc->sum_p += hsum_ps_sse2(sum_p);
+    acc->sum_v2 += hsum_ps_sse2(sum_v2);
+    acc->sum_i2 += hsum_ps_sse2(sum_i2);
+    acc->max_p = hmax_ps_sse2(max_p);
+    power_chunk_tail(voltage, current, k, n, power, acc);
+}
+
+__attribute__((target("avx2")))
+static void power_chunk_avx2(const float* voltage, const float* current, size_t n,
+                             float* power, power_chunk_t* acc) {
+    __m256 sum_p = _mm256_setzero_ps();
+    __m256 sum_v2 = _mm256_setzero_ps();
+    __m256 sum_i2 = _mm256_setzero_ps();
+    __m256 max_p = _mm256_set1_ps(acc->max_p);
+    size_t k = 0;
+    
+    for (; k + 8 <= n; k += 8) {
+        __m256 v = _mm256_loadu_ps(voltage + k);
+        __m256 i = _mm256_loadu_ps(current + k);
+        __m256 p = _mm256_mul_ps(v, i);
+        _mm256_storeu_ps(power + k, p);
+        sum_p = _mm256_add_ps(sum_p, p);
+        sum_v2 = _mm256_add_ps(sum_v2, _mm256_mul_ps(v, v));
+        sum_i2 = _mm256_add_ps(sum_i2, _mm256_mul_ps(i, i));
+        max_p = _mm256_max_ps(max_p, p);
+    }
+    
+    acc->sum_p += hsum_ps_sse2(_mm_add_ps(_mm256_castps256_ps128(sum_p),
+                                          _mm256_extractf128_ps(sum_p, 1)));
+    acc->sum_v2 += hsum_ps_sse2(_mm_add_ps(_mm256_castps256_ps128(sum_v2),
+                                           _mm256_extractf128_ps(sum_v2, 1)));
+    acc->sum_i2 += hsum_ps_sse2(_mm_add_ps(_mm256_castps256_ps128(sum_i2),
+                                           _mm256_extractf128_ps(sum_i2, 1)));
+    acc->max_p = hmax_ps_sse2(_mm_max_ps(_mm256_castps256_ps128(max_p),
+                                         _mm256_extractf128_ps(max_p, 1)));
+    power_chunk_tail(voltage, current, k, n, power, acc);
+}
+
+#endif // POWER_ANALYZER_X86
+
+static power_chunk_fn power_chunk_impl = 0;
+static const char* power_isa = "scalar";
+
+// Every thread resolves to the same pointer, so a racing first call is harmless
+static void power_analyzer_resolve(void) {
+    power_chunk_impl = power_chunk_scalar;
+    power_isa = "scalar";
+
+#ifdef POWER_ANALYZER_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        power_chunk_impl = power_chunk_avx2;
+        power_isa = "avx2";
+    } else {
+        power_chunk_impl = power_chunk_sse2;
+        power_isa = "sse2";
+    }
+#endif
+}
+
+const char* power_analyzer_isa(void) {
+    if (!power_chunk_impl) {
+        power_analyzer_resolve();
+    }
+    return power_isa;
+}
+
+const char* power_analyzer_violation_name(power_violation_type_t type) {
+    switch (type) {
+        case POWER_VIOLATION_PEAK:        return "peak";
+        case POWER_VIOLATION_WINDOW_HIGH: return "window high";
+        case POWER_VIOLATION_WINDOW_LOW:  return "window low";
+        default:                          return "unknown";
+    }
+}
+
+int power_analyzer_init(power_analyzer_t* analyzer, const power_analyzer_config_t* config) {
+    if (!analyzer || !config || config->sample_rate_hz <= 0.0 ||
+        config->window_samples == 0 || !config->window_storage) {
+        return -1;
+    }
+    
+    *analyzer = (power_analyzer_t){0};
+    analyzer->config = *config;
+    analyzer->peak_w = -INFINITY;
+    analyzer->window_max_w = -INFINITY;
+    analyzer->window_min_w = INFINITY;
+    for (int type = 0; type < POWER_VIOLATION_TYPES; type++) {
+        analyzer->open[type].event.type = (power_violation_type_t)type;
+    }
+    if (!power_chunk_impl) {
+        power_analyzer_resolve();
+    }
+    return 0;
+}
+
+static uint64_t power_sample_ns(const power_analyzer_t* analyzer, uint64_t sample) {
+    return (uint64_t)((double)sample * 1e9 / analyzer->config.sample_rate_hz);
+}
+
+static void power_violation_close(power_analyzer_t* analyzer, power_violation_state_t* state,
+                                  uint64_t end_sample) {
+    state->active = 0;
+    state->event.end_sample = end_sample;
+    state->event.start_ns = power_sample_ns(analyzer, state->event.start_sample);
+    state->event.end_ns = power_sample_ns(analyzer, end_sample);
+    analyzer->violations[state->event.type]++;
+    
+    if (analyzer->config.callback) {
+        analyzer->config.callback(&state->event, analyzer->config.callback_context);
+    }
+}
+
+// Edge-triggered: a violation opens on the first offending sample, tracks
+// its worst value, and is reported once when the signal recovers
+static void power_violation_track(power_analyzer_t* analyzer, power_violation_type_t type,
+                                  int violated, double value, uint64_t sample) {
+    power_violation_state_t* state = &analyzer->open[type];
+    int lower_is_worse = (type == POWER_VIOLATION_WINDOW_LOW);
+    
+    if (violated) {
+        if (!state->active) {
+            state->active = 1;
+            state->event.start_sample = sample;
+            state->event.worst_w = value;
+        } else if (lower_is_worse ? value < state->event.worst_w : value > state->event.worst_w) {
+            state->event.worst_w = value;
+        }
+    } else if (state->active) {
+        power_violation_close(analyzer, state, sample);
+    }
+}
+
+static void power_window_pass(power_analyzer_t* analyzer, const float* power, size_t n) {
+    const power_analyzer_config_t* config = &analyzer->config;
+    float* ring = config->window_storage;
+    uint32_t window = config->window_samples;
+    double inv_window = 1.0 / window;
+    
+    for (size_t k = 0; k < n; k++) {
+        uint64_t sample = analyzer->samples + k;
+        float p = power[k];
+        
+        if (analyzer->window_fill == window) {
+            analyzer->window_sum -= ring[analyzer->window_pos];
+        } else {
+            analyzer->window_fill++;
+        }
+        ring[analyzer->window_pos] = p;
+        analyzer->window_sum += p;
+        if (++analyzer->window_pos == window) {
+            analyzer->window_pos = 0;
+            // Rebuild the sum so add/subtract rounding can't accumulate
+            double sum = 0.0;
+            for (uint32_t w = 0; w < analyzer->window_fill; w++) {
+                sum += ring[w];
+            }
+            analyzer->window_sum = sum;
+        }
+        
+        if (config->peak_limit_w > 0.0f) {
+            power_violation_track(analyzer, POWER_VIOLATION_PEAK, p > config->peak_limit_w,
+                                  p, sample);
+        }
+        if (analyzer->window_fill < window) continue;
+        
+        double average = analyzer->window_sum * inv_window;
+        if (average > analyzer->window_max_w) analyzer->window_max_w = average;
+        if (average < analyzer->window_min_w) analyzer->window_min_w = average;
+        if (config->window_high_w > 0.0f) {
+            power_violation_track(analyzer, POWER_VIOLATION_WINDOW_HIGH,
+                                  average > config->window_high_w, average, sample);
+        }
+        if (config->window_low_w > 0.0f) {
+            power_violation_track(analyzer, POWER_VIOLATION_WINDOW_LOW,
+                                  average < config->window_low_w, average, sample);
+        }
+    }
+}
+
+static void power_process_chunk(power_analyzer_t* analyzer, const float* voltage,
+                                const float* current, size_t n) {
+    float power[POWER_CHUNK];
+    power_chunk_t acc = {0.0, 0.0, 0.0, -INFINITY};
+    power_chunk_impl(voltage, current, n, power, &acc);
+    
+    analyzer->sum_p += acc.sum_p;
+    analyzer->sum_v2 += acc.sum_v2;
+    analyzer->sum_i2 += acc.sum_i2;
+    if (acc.max_p > analyzer->peak_w) {
+        // New peak: find its first position (rare, so scalar)
+        for (size_t k = 0; k < n; k++) {
+            if (power[k] == acc.max_p) {
+                analyzer->peak_w = acc.max_p;
+                analyzer->peak_sample = analyzer->samples + k;
+                break;
+            }
+        }
+    }
+    
+    power_window_pass(analyzer, power, n);
+    analyzer->samples += n;
+}
+
+void power_analyzer_process(power_analyzer_t* analyzer, const float* voltage,
+                            const float* current, size_t n) {
+    for (size_t offset = 0; offset < n; offset += POWER_CHUNK) {
+        size_t count = (n - offset < POWER_CHUNK) ? n - offset : POWER_CHUNK;
+        power_process_chunk(analyzer, voltage + offset, current + offset, count);
+    }
+}
+
+void power_analyzer_process_adc(power_analyzer_t* analyzer, const uint16_t* samples,
+                                size_t frame_count, uint32_t stride,
+                                uint32_t voltage_slot, uint32_t current_slot) {
+    float voltage[POWER_CHUNK];
+    float current[POWER_CHUNK];
+    float volts_per_lsb = analyzer->config.volts_per_lsb;
+    float amps_per_lsb = analyzer->config.amps_per_lsb;
+    
+    for (size_t offset = 0; offset < frame_count; offset += POWER_CHUNK) {
+        size_t count = (frame_count - offset < POWER_CHUNK) ? frame_count - offset : POWER_CHUNK;
+        const uint16_t* frame = samples + offset * stride;
+        for (size_t k = 0; k < count; k++, frame += stride) {
+            voltage[k] = frame[voltage_slot] * volts_per_lsb;
+            current[k] = frame[current_slot] * amps_per_lsb;
+        }
+        power_process_chunk(analyzer, voltage, current, count);
+    }
+}
+
+void power_analyzer_finish(power_analyzer_t* analyzer) {
+    for (int type = 0; type < POWER_VIOLATION_TYPES; type++) {
+        if (analyzer->open[type].active) {
+            power_violation_close(analyzer, &analyzer->open[type], analyzer->samples);
+        }
+    }
+}
+
+void power_analyzer_summary(const power_analyzer_t* analyzer, power_summary_t* summary) {
+    *summary = (power_summary_t){0};
+    summary->samples = analyzer->samples;
+    for (int type = 0; type < POWER_VIOLATION_TYPES; type++) {
+        summary->violations[type] = analyzer->violations[type];
+    }
+    if (analyzer->samples == 0) return;
+    
+    double n = (double)analyzer->samples;
+    summary->duration_s = n / analyzer->config.sample_rate_hz;
+    summary->energy_j = analyzer->sum_p / analyzer->config.sample_rate_hz;
+    summary->average_w = analyzer->sum_p / n;
+    summary->peak_w = analyzer->peak_w;
+    summary->peak_ns = power_sample_ns(analyzer, analyzer->peak_sample);
+    summary->rms_voltage = sqrt(analyzer->sum_v2 / n);
+    summary->rms_current = sqrt(analyzer->sum_i2 / n);
+    if (analyzer->window_fill == analyzer->config.window_samples) {
+        summary->window_max_w = analyzer->window_max_w;
+        summary->window_min_w = analyzer->window_min_w;
+    }
+}
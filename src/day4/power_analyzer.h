@@ -0,0 +1,106 @@
+#ifndef POWER_ANALYZER_H
+#define POWER_ANALYZER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Streaming power analyzer for paired voltage/current samples. Blocks are
+// consumed as they arrive (e.g. from hal_adc_stream_acquire()) and nothing
+// but the sliding window is stored, so captures of any length run in
+// constant memory. Per sample it forms p = v * i (vectorized on x86-64) and
+// tracks:
+//   - energy, average and peak power, RMS voltage and current
+//   - a sliding-window average power and its extremes
+//   - limit violations on peak and window-average power, each reported once
+//     with the sample span and timestamps over which it lasted
+//
+// Window limits are only checked once the window is full. A limit of 0
+// disables that check.
+
+typedef enum {
+    POWER_VIOLATION_PEAK = 0,      // Instantaneous power above peak_limit_w
+    POWER_VIOLATION_WINDOW_HIGH,   // Window average above window_high_w
+    POWER_VIOLATION_WINDOW_LOW,    // Window average below window_low_w (e.g. idle floor)
+    POWER_VIOLATION_TYPES
+} power_violation_type_t;
+
+typedef struct {
+    power_violation_type_t type;
+    uint64_t start_sample;
+    uint64_t end_sample;           // Exclusive
+    uint64_t start_ns;             // From sample_rate_hz, relative to the first sample
+    uint64_t end_ns;
+    double worst_w;                // Highest (or, for WINDOW_LOW, lowest) value seen
+} power_violation_t;
+
+typedef void (*power_violation_callback_t)(const power_violation_t* violation, void* context);
+
+typedef struct {
+    double sample_rate_hz;
+    uint32_t window_samples;
+    float* window_storage;         // window_samples floats, owned by the caller
+    float peak_limit_w;
+    float window_high_w;
+    float window_low_w;
+    float volts_per_lsb;           // Scaling for power_analyzer_process_adc()
+    float amps_per_lsb;
+    power_violation_callback_t callback;  // May be NULL
+    void* callback_context;
+} power_analyzer_config_t;
+
+typedef struct {
+    uint64_t samples;
+    double duration_s;
+    double energy_j;
+    double average_w;
+    double peak_w;
+    uint64_t peak_ns;
+    double rms_voltage;
+    double rms_current;
+    double window_max_w;           // Extremes of the full-window average
+    double window_min_w;
+    uint32_t violations[POWER_VIOLATION_TYPES];
+} power_summary_t;
+
+typedef struct {
+    int active;
+    power_violation_t event;
+} power_violation_state_t;
+
+typedef struct {
+    power_analyzer_config_t config;
+    uint64_t samples;
+    double sum_p;
+    double sum_v2;
+    double sum_i2;
+    float peak_w;
+    uint64_t peak_sample;
+    
+    // Sliding window ring; the sum is rebuilt exactly on each wrap
+    double window_sum;
+    uint32_t window_pos;
+    uint32_t window_fill;
+    double window_max_w;
+    double window_min_w;
+    
+    power_violation_state_t open[POWER_VIOLATION_TYPES];
+    uint32_t violations[POWER_VIOLATION_TYPES];
+} power_analyzer_t;
+
+int power_analyzer_init(power_analyzer_t* analyzer, const power_analyzer_config_t* config);
+void power_analyzer_process(power_analyzer_t* analyzer, const float* voltage,
+                            const float* current, size_t n);
+
+// Interleaved ADC frames (stride samples per frame, as in hal_adc_block_t),
+// voltage and current at the given slots, scaled by the config LSB sizes
+void power_analyzer_process_adc(power_analyzer_t* analyzer, const uint16_t* samples,
+                                size_t frame_count, uint32_t stride,
+                                uint32_t voltage_slot, uint32_t current_slot);
+
+// Closes violations still in progress; call at the end of a capture
+void power_analyzer_finish(power_analyzer_t* analyzer);
+void power_analyzer_summary(const power_analyzer_t* analyzer, power_summary_t* summary);
+const char* power_analyzer_violation_name(power_violation_type_t type);
+const char* power_analyzer_isa(void);
+
+#endif // POWER_ANALYZER_H
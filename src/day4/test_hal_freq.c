@@ -0,0 +1,88 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "fpga_hal.h"
+#include "hal_backend.h"
+#include "hal_sim.h"
+#include "validation_lib.h"
+
+// Frequency counter against simulated clock sources: gate mode on fast
+// clocks (including one above 4.29 GHz), reciprocal mode on a sub-hertz
+// reference where gate counting is hopeless, the no-signal paths, and the
+// 64-bit ppm validators at their boundaries.
+
+static int failures = 0;
+
+static void check(const char* what, int ok) {
+    printf("  %-44s %s\n", what, ok ? "OK" : "FAIL");
+    if (!ok) failures++;
+}
+
+static hal_freq_result_t measure(uint32_t pin, uint64_t millihertz, hal_freq_mode_t mode,
+                                 uint32_t gate_us, uint32_t gate_count, int* status) {
+    hal_freq_result_t result;
+    hal_sim_clock_set(pin, millihertz);
+    hal_freq_init(pin);
+    *status = hal_freq_measure(mode, gate_us, gate_count, &result);
+    return result;
+}
+
+int main(void) {
+    hal_system_init();
+    if (strcmp(hal_backend_name(), "sim") != 0) {
+        printf("Frequency counter test needs the sim backend (have %s), skipped\n",
+               hal_backend_name());
+        return 0;
+    }
+    
+    int status;
+    printf("Gate mode:\n");
+    hal_freq_result_t fast = measure(4, 12345678000ull, HAL_FREQ_GATE, 100000, 10, &status);
+    printf("  12.345678 MHz -> %llu Hz over %u gates (%lld ppm)\n",
+           (unsigned long long)fast.hz, (unsigned)fast.gates,
+           (long long)frequency_error_ppm(fast.hz, 12345678));
+    check("measured", status == 0 && fast.gates == 10);
+    check("within 20 ppm", validate_frequency_ppm(fast.hz, 12345678, 20));
+    check("per-gate spread brackets the mean",
+          fast.min_millihertz <= fast.millihertz && fast.millihertz <= fast.max_millihertz);
+    
+    hal_freq_result_t ghz = measure(5, 5200000000000ull, HAL_FREQ_GATE, 1000000, 1, &status);
+    printf("  5.2 GHz -> %llu Hz (%llu edges)\n",
+           (unsigned long long)ghz.hz, (unsigned long long)ghz.edges);
+    check("above 32-bit range", status == 0 && ghz.hz > UINT32_MAX && ghz.edges > UINT32_MAX);
+    check("within 20 ppm", validate_frequency_ppm(ghz.hz, 5200000000ull, 20));
+    
+    printf("Reciprocal mode:\n");
+    hal_freq_result_t slow = measure(6, 1500, HAL_FREQ_RECIPROCAL, 2000000, 3, &status);
+    printf("  1.5 Hz -> %llu mHz (%llu periods in %llu us)\n",
+           (unsigned long long)slow.millihertz, (unsigned long long)slow.edges,
+           (unsigned long long)slow.ticks);
+    check("measured", status == 0);
+    check("within 2 ppm", validate_frequency_ppm(slow.millihertz, 1500, 2));
+    
+    hal_freq_result_t coarse = measure(6, 1500, HAL_FREQ_GATE, 2000000, 3, &status);
+    printf("  1.5 Hz by gate counting -> %llu mHz\n", (unsigned long long)coarse.millihertz);
+    check("reciprocal beats gate counting",
+          frequency_error_ppm(coarse.millihertz, 1500) != 0);
+    
+    printf("No signal:\n");
+    measure(7, 0, HAL_FREQ_GATE, 1000, 2, &status);
+    check("gate mode reports no signal", status == -1);
+    measure(7, 0, HAL_FREQ_RECIPROCAL, 1000, 2, &status);
+    check("reciprocal mode reports no signal", status == -1);
+    measure(7, 100000, HAL_FREQ_RECIPROCAL, 1000, 2, &status);
+    check("reciprocal gate shorter than a period", status == -1);
+    
+    printf("ppm validators:\n");
+    check("boundary passes", validate_frequency_ppm(1000100000ull, 1000000000ull, 100));
+    check("one past the boundary fails", !validate_frequency_ppm(1000100001ull, 1000000000ull, 100));
+    check("below the boundary passes", validate_frequency_ppm(999900000ull, 1000000000ull, 100));
+    check("no overflow near UINT64_MAX",
+          validate_frequency_ppm(UINT64_MAX - 1, UINT64_MAX / 2, 1000000) &&
+          !validate_frequency_ppm(UINT64_MAX, UINT64_MAX / 4, 1000000));
+    check("error sign", frequency_error_ppm(999000, 1000000) == -1000 &&
+                        frequency_error_ppm(1001000, 1000000) == 1000);
+    
+    printf("Frequency counter: %s\n", failures == 0 ? "all checks passed" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "limits_table.h"
+#include "validation_lib.h"
+
+// Limits table end to end: limits_compile turns the shipped spec sheet into
+// a table whose lookups find every row and nothing else, rejects duplicate
+// IDs and lo > hi, and limits_open_image() refuses truncated and corrupted
+// images instead of reading past them.
+//
+// usage: limits_table_test <limits_compile> <fpga_limits.csv>
+
+static int failures = 0;
+
+static void check(const char* what, int ok) {
+    printf("  %-48s %s\n", what, ok ? "OK" : "FAIL");
+    if (!ok) failures++;
+}
+
+static int compile(const char* compiler, const char* csv, const char* bin) {
+    char command[1024];
+    snprintf(command, sizeof(command), "\"%s\" \"%s\" \"%s\"", compiler, csv, bin);
+    return system(command);
+}
+
+static int write_text(const char* path, const char* text) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        perror(path);
+        return -1;
+    }
+    fputs(text, file);
+    return fclose(file);
+}
+
+static uint8_t* read_file(const char* path, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    
+    uint8_t* data = length > 0 ? malloc((size_t)length) : NULL;
+    if (data && fread(data, 1, (size_t)length, file) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *size = data ? (size_t)length : 0;
+    return data;
+}
+
+static void check_lookups(const char* compiler, const char* csv) {
+    printf("Compile and look up:\n");
+    check("fpga_limits.csv compiles", compile(compiler, csv, "limits_test.bin") == 0);
+    check("table opens", limits_open("limits_test.bin") == 0);
+    
+    // Every data row of the spec sheet must be found with its own values
+    FILE* file = fopen(csv, "r");
+    char line[256];
+    int rows = 0;
+    int found = 0;
+    while (file && fgets(line, sizeof(line), file)) {
+        char id[64];
+        double expected, lo, hi;
+        if (line[0] == '#' || sscanf(line, "%63[^,],%lf,%lf,%lf", id, &expected, &lo, &hi) != 4) {
+            continue;
+        }
+        limits_t limits;
+        rows++;
+        if (limits_lookup(id, &limits) && strcmp(limits.test_id, id) == 0 &&
+            limits.expected == expected && limits.lo == lo && limits.hi == hi) {
+            found++;
+        }
+    }
+    if (file) {
+        fclose(file);
+    }
+    printf("  %d of %d spec rows found\n", found, rows);
+    check("every spec row found with its limits", rows > 0 && found == rows);
+    check("entry count matches", limits_count() == (uint32_t)rows);
+    
+    check("missing ID not found", !limits_lookup("no_such_test", NULL));
+    check("prefix of an ID not found", !limits_lookup("core_volt", NULL));
+    check("empty ID not found", !limits_lookup("", NULL));
+    check("validate_limits inside", validate_limits("core_voltage", 3.30));
+    check("validate_limits on the inclusive edge", validate_limits("core_voltage", 3.40));
+    check("validate_limits outside", !validate_limits("core_voltage", 3.41));
+    check("validate_limits on a missing ID", !validate_limits("no_such_test", 0.0));
+    limits_close();
+    check("closed table finds nothing", !limits_lookup("core_voltage", NULL));
+}
+
+static void check_rejected_specs(const char* compiler) {
+    printf("Spec errors:\n");
+    write_text("limits_duplicate.csv",
+               "test_id,expected,lo,hi,units\n"
+               "rail_a,1.0,0.9,1.1,V\n"
+               "rail_b,2.0,1.9,2.1,V\n"
+               "rail_a,1.0,0.9,1.1,V\n");
+    check("duplicate test_id rejected",
+          compile(compiler, "limits_duplicate.csv", "limits_duplicate.bin") != 0);
+    
+    write_text("limits_inverted.csv",
+               "test_id,expected,lo,hi,units\n"
+               "rail_a,1.0,1.1,0.9,V\n");
+    check("lo > hi rejected",
+          compile(compiler, "limits_inverted.csv", "limits_inverted.bin") != 0);
+    
+    write_text("limits_equal.csv",
+               "test_id,expected,lo,hi,units\n"
+               "rail_a,1.0,1.0,1.0,V\n");
+    check("lo == hi accepted",
+          compile(compiler, "limits_equal.csv", "limits_equal.bin") == 0);
+}
+
+// Copy, damage one header field, and expect limits_open_image() to refuse it
+static int corrupt_rejected(const uint8_t* image, size_t size, size_t field_offset,
+                            uint32_t value) {
+    uint8_t* copy = malloc(size);
+    memcpy(copy, image, size);
+    memcpy(copy + field_offset, &value, sizeof(value));
+    int rejected = limits_open_image(copy, size) != 0;
+    limits_close();
+    free(copy);
+    return rejected;
+}
+
+static void check_bad_images(void) {
+    printf("Bad images:\n");
+    size_t size = 0;
+    uint8_t* image = read_file("limits_test.bin", &size);
+    check("compiled image read back", image != NULL);
+    if (!image) {
+        return;
+    }
+    
+    check("intact image accepted", limits_open_image(image, size) == 0);
+    limits_close();
+    
+    // Every truncation: short headers, cut entries, index and string area
+    int truncated_ok = 1;
+    for (size_t cut = 0; cut < size; cut++) {
+        uint8_t* copy = malloc(cut ? cut : 1);
+        memcpy(copy, image, cut);
+        if (limits_open_image(copy, cut) == 0) {
+            truncated_ok = 0;
+        }
+        limits_close();
+        free(copy);
+    }
+    check("every truncation rejected", truncated_ok);
+    
+    const limits_file_header_t* header = (const limits_file_header_t*)image;
+    check("bad magic",
+          corrupt_rejected(image, size, offsetof(limits_file_header_t, magic), 0x12345678u));
+    check("future version",
+          corrupt_rejected(image, size, offsetof(limits_file_header_t, version),
+                           LIMITS_VERSION + 1));
+    check("bucket count not a power of two",
+          corrupt_rejected(image, size, offsetof(limits_file_header_t, bucket_count),
+                           header->bucket_count + 1));
+    check("index over half full",
+          corrupt_rejected(image, size, offsetof(limits_file_header_t, entry_count),
+                           header->bucket_count));
+    check("entries past the end",
+          corrupt_rejected(image, size, offsetof(limits_file_header_t, entries_offset),
+                           (uint32_t)size));
+    check("misaligned entries",
+          corrupt_rejected(image, size, offsetof(limits_file_header_t, entries_offset),
+                           header->entries_offset + 4));
+    check("index past the end",
+          corrupt_rejected(image, size, offsetof(limits_file_header_t, index_offset),
+                           0xFFFFFFF0u));
+    check("string area past the end",
+          corrupt_rejected(image, size, offsetof(limits_file_header_t, strings_size),
+                           header->strings_size + 1));
+    check("string ID offset outside the string area",
+          corrupt_rejected(image, size, header->entries_offset +
+                           offsetof(limits_file_entry_t, id_offset), header->strings_size));
+    check("index slot past the entries",
+          corrupt_rejected(image, size, header->index_offset, header->entry_count + 1));
+    
+    // Unterminated string area: the last NUL is the units of the last entry
+    uint8_t* copy = malloc(size);
+    memcpy(copy, image, size);
+    copy[header->strings_offset + header->strings_size - 1] = 'x';
+    check("unterminated string rejected", limits_open_image(copy, size) != 0);
+    limits_close();
+    free(copy);
+    free(image);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <limits_compile> <fpga_limits.csv>\n", argv[0]);
+        return 2;
+    }
+    
+    check_lookups(argv[1], argv[2]);
+    check_rejected_specs(argv[1]);
+    check_bad_images();
+    
+    if (failures) {
+        printf("%d limits table check(s) FAILED\n", failures);
+        return 1;
+    }
+    printf("All limits table checks passed\n");
+    return 0;
+}
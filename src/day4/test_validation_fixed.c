@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "validation_lib.h"
+
+// Cross-check: the integer validators must reach the same verdict as the
+// float ones wherever the float path computes exactly.
+//   - Q16.16: inputs on a grid floats hold exactly (8 integer bits, and for
+//     products 8 fractional bits per factor), swept exhaustively.
+//   - mV: every verdict must match, except exact ties |m - e| == tol, where
+//     the float path rounds 1.85 - 1.80 above 0.05; there the integer path
+//     is the correct one and the ties are only counted.
+//   - ADC: the integer conversion must agree with the float one to 0.5 mV.
+
+static int failures = 0;
+
+static void check(const char* what, bool ok, long long detail_a, long long detail_b) {
+    if (!ok) {
+        if (failures < 10) {
+            printf("  MISMATCH %s (%lld, %lld)\n", what, detail_a, detail_b);
+        }
+        failures++;
+    }
+}
+
+static float q16_to_float(q16_16_t value) {
+    return (float)value / 65536.0f;
+}
+
+static void check_voltage_q16(void) {
+    const q16_16_t expected_values[] = { Q16_FROM_MV(1800), Q16_FROM_MV(3300), Q16_FROM_INT(5) };
+    const q16_16_t tolerance_values[] = { Q16_FROM_MV(50), Q16_FROM_MV(100), 1 };
+    long long cases = 0;
+    
+    for (int e = 0; e < 3; e++) {
+        for (int t = 0; t < 3; t++) {
+            q16_16_t expected = expected_values[e];
+            q16_16_t tolerance = tolerance_values[t];
+            // Every Q16.16 step across and well beyond both boundaries
+            for (q16_16_t measured = expected - tolerance - 4096;
+                 measured <= expected + tolerance + 4096; measured++) {
+                bool fixed = validate_voltage_q16(measured, expected, tolerance);
+                bool floating = validate_voltage(q16_to_float(measured), q16_to_float(expected),
+                                                 q16_to_float(tolerance));
+                check("voltage_q16", fixed == floating, measured, expected);
+                cases++;
+            }
+        }
+    }
+    printf("validate_voltage_q16:  %lld cases\n", cases);
+}
+
+static void check_power_q16(void) {
+    const q16_16_t max_values[] = { Q16_FROM_INT(4), Q16_FROM_MV(3960), Q16_FROM_INT(1) + 256 };
+    long long cases = 0;
+    
+    // Factors in [0, 16) with 8 fractional bits: the float product is exact
+    for (int32_t v = 0; v < 4096; v += 3) {
+        for (int32_t i = 0; i < 4096; i++) {
+            q16_16_t voltage = v << 8;
+            q16_16_t current = i << 8;
+            for (int m = 0; m < 3; m++) {
+                bool fixed = validate_power_q16(voltage, current, max_values[m]);
+                bool floating = validate_power(q16_to_float(voltage), q16_to_float(current),
+                                               q16_to_float(max_values[m]));
+                check("power_q16", fixed == floating, voltage, current);
+                cases++;
+            }
+        }
+    }
+    printf("validate_power_q16:    %lld cases\n", cases);
+}
+
+static void check_voltage_mv(void) {
+    const int32_t expected_values[] = { 1800, 3300, 1000 };
+    const int32_t tolerance_values[] = { 50, 100, 5 };
+    long long cases = 0;
+    long long ties = 0;
+    
+    for (int e = 0; e < 3; e++) {
+        for (int t = 0; t < 3; t++) {
+            for (int32_t measured = 0; measured <= 5000; measured++) {
+                int32_t expected = expected_values[e];
+                int32_t tolerance = tolerance_values[t];
+                bool fixed = validate_voltage_mv(measured, expected, tolerance);
+                bool floating = validate_voltage(measured / 1000.0f, expected / 1000.0f,
+                                                 tolerance / 1000.0f);
+                int32_t diff = measured > expected ? measured - expected : expected - measured;
+                if (diff == tolerance) {
+                    ties++;
+                    check("voltage_mv tie", fixed, measured, expected);
+                } else {
+                    check("voltage_mv", fixed == floating, measured, expected);
+                }
+                cases++;
+            }
+        }
+    }
+    printf("validate_voltage_mv:   %lld cases (%lld exact ties)\n", cases, ties);
+}
+
+static void check_power_mv_ua(void) {
+    long long cases = 0;
+    long long ties = 0;
+    
+    for (int32_t voltage_mv = 3000; voltage_mv <= 3600; voltage_mv += 10) {
+        for (int32_t current_ua = 1000000; current_ua <= 1400000; current_ua += 1000) {
+            int64_t power_nw = (int64_t)voltage_mv * current_ua;
+            bool fixed = validate_power_mv_ua(voltage_mv, current_ua, 4000000);
+            bool floating = validate_power(voltage_mv / 1000.0f, current_ua / 1000000.0f, 4.0f);
+            if (power_nw == 4000000000ll) {
+                ties++;
+                check("power_mv_ua tie", fixed, voltage_mv, current_ua);
+            } else {
+                check("power_mv_ua", fixed == floating, voltage_mv, current_ua);
+            }
+            cases++;
+        }
+    }
+    printf("validate_power_mv_ua:  %lld cases (%lld exact ties)\n", cases, ties);
+}
+
+static void check_adc_conversion(void) {
+    for (uint32_t code = 0; code <= VALIDATION_ADC_FULL_SCALE; code++) {
+        float volts = (code * 3.3f) / 4095.0f;
+        float error_mv = (float)adc_to_millivolts((uint16_t)code) - volts * 1000.0f;
+        float error_q16 = q16_to_float(adc_to_q16((uint16_t)code)) - volts;
+        check("adc_to_millivolts", error_mv <= 0.5f + 1e-3f && error_mv >= -0.5f - 1e-3f,
+              code, adc_to_millivolts((uint16_t)code));
+        check("adc_to_q16", error_q16 <= 1.0f / 65536.0f && error_q16 >= -1.0f / 65536.0f,
+              code, adc_to_q16((uint16_t)code));
+    }
+    printf("adc conversion:        %d codes\n", VALIDATION_ADC_FULL_SCALE + 1);
+}
+
+int main(void) {
+    printf("Fixed-point vs. float validation cross-check\n");
+    printf("============================================\n");
+    
+    check_voltage_q16();
+    check_power_q16();
+    check_voltage_mv();
+    check_power_mv_ua();
+    check_adc_conversion();
+    
+    printf("%s: %d mismatches\n", failures ? "FAIL" : "PASS", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,226 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "validation_lib.h"
+#include "validation_sink.h"
+
+// Result sinks byte for byte: CSV quoting, JSON Lines escaping (and the null
+// context), the binary header and record layout, records too large for the
+// buffer, and the record order through a context across batch, buffer and
+// flush boundaries.
+
+static int failures = 0;
+
+static void check(const char* what, int ok) {
+    printf("  %-48s %s\n", what, ok ? "OK" : "FAIL");
+    if (!ok) failures++;
+}
+
+static validation_record_t make_record(uint64_t sequence, const char* name, bool passed,
+                                       float measured, float expected) {
+    validation_record_t record;
+    memset(&record, 0, sizeof(record));
+    record.sequence = sequence;
+    record.passed = passed;
+    record.measured = measured;
+    record.expected = expected;
+    strncpy(record.test_name, name, VALIDATION_RECORD_NAME_LEN - 1);
+    return record;
+}
+
+// Everything the sink wrote, NUL-terminated
+static size_t read_back(FILE* stream, char* out, size_t room) {
+    rewind(stream);
+    size_t length = fread(out, 1, room - 1, stream);
+    out[length] = '\0';
+    return length;
+}
+
+static void check_csv(void) {
+    printf("CSV:\n");
+    FILE* stream = tmpfile();
+    validation_sink_t sink;
+    check("opens", validation_sink_open(&sink, VALIDATION_SINK_CSV, stream, 0) == 0);
+    
+    validation_record_t records[3] = {
+        make_record(0, "plain", true, 1.5f, 1.5f),
+        make_record(1, "a,b", false, 2.0f, 1.0f),
+        make_record(2, "say \"hi\"\nagain", true, 0.25f, 0.25f),
+    };
+    validation_sink_write(&sink, "board,1", records, 3);
+    validation_sink_close(&sink);
+    
+    char text[1024];
+    read_back(stream, text, sizeof(text));
+    check("header row; quoted comma, quote and newline",
+          strcmp(text,
+                 "context,sequence,test,passed,measured,expected\n"
+                 "\"board,1\",0,plain,1,1.5,1.5\n"
+                 "\"board,1\",1,\"a,b\",0,2,1\n"
+                 "\"board,1\",2,\"say \"\"hi\"\"\nagain\",1,0.25,0.25\n") == 0);
+    fclose(stream);
+}
+
+static void check_jsonl(void) {
+    printf("JSON Lines:\n");
+    FILE* stream = tmpfile();
+    validation_sink_t sink;
+    check("opens", validation_sink_open(&sink, VALIDATION_SINK_JSONL, stream, 0) == 0);
+    
+    validation_record_t escaped = make_record(7, "q\"b\\n\nt\t\x01", false, 3.5f, 3.25f);
+    validation_record_t plain = make_record(8, "rail", true, 1.0f, 1.0f);
+    validation_sink_write(&sink, "b\"1", &escaped, 1);
+    validation_sink_write(&sink, NULL, &plain, 1);
+    validation_sink_close(&sink);
+    
+    char text[1024];
+    read_back(stream, text, sizeof(text));
+    check("escaped quote, backslash, controls; null context",
+          strcmp(text,
+                 "{\"context\":\"b\\\"1\",\"seq\":7,\"test\":\"q\\\"b\\\\n\\u000at\\u0009\\u0001\","
+                 "\"passed\":false,\"measured\":3.5,\"expected\":3.25}\n"
+                 "{\"context\":null,\"seq\":8,\"test\":\"rail\","
+                 "\"passed\":true,\"measured\":1,\"expected\":1}\n") == 0);
+    fclose(stream);
+}
+
+static uint32_t load_u32(const unsigned char* bytes) {
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+static void check_binary(void) {
+    printf("Binary:\n");
+    FILE* stream = tmpfile();
+    validation_sink_t sink;
+    check("opens", validation_sink_open(&sink, VALIDATION_SINK_BINARY, stream, 0) == 0);
+    
+    validation_record_t records[2] = {
+        make_record(0x0102030405060708ull, "core_voltage", true, 3.3f, 3.25f),
+        make_record(9, "a_name_of_exactly_thirty_one_ch", false, -1.0f, 0.0f),
+    };
+    validation_sink_write(&sink, "ignored", records, 2);
+    validation_sink_close(&sink);
+    
+    unsigned char data[256];
+    rewind(stream);
+    size_t size = fread(data, 1, sizeof(data), stream);
+    check("header plus two 52-byte records",
+          size == VALIDATION_BINARY_HEADER_SIZE + 2 * VALIDATION_BINARY_RECORD_SIZE);
+    check("header: magic, version, record size",
+          load_u32(data) == VALIDATION_BINARY_MAGIC &&
+          load_u32(data + 4) == VALIDATION_BINARY_VERSION &&
+          load_u32(data + 8) == VALIDATION_BINARY_RECORD_SIZE);
+    
+    const unsigned char* first = data + VALIDATION_BINARY_HEADER_SIZE;
+    const unsigned char* second = first + VALIDATION_BINARY_RECORD_SIZE;
+    uint64_t sequence;
+    float measured, expected;
+    memcpy(&sequence, first, 8);
+    memcpy(&measured, first + 8, 4);
+    memcpy(&expected, first + 12, 4);
+    check("u64 sequence, f32 measured, f32 expected",
+          sequence == 0x0102030405060708ull && measured == 3.3f && expected == 3.25f);
+    check("flags: bit 0 is passed", load_u32(first + 16) == 1u && load_u32(second + 16) == 0u);
+    
+    int padded = 1;
+    for (size_t i = strlen("core_voltage"); i < VALIDATION_RECORD_NAME_LEN; i++) {
+        padded = padded && first[20 + i] == '\0';
+    }
+    check("name NUL-padded to 32 bytes",
+          memcmp(first + 20, "core_voltage", 12) == 0 && padded);
+    check("31-char name kept, terminated",
+          memcmp(second + 20, "a_name_of_exactly_thirty_one_ch", 31) == 0 && second[51] == '\0');
+    fclose(stream);
+}
+
+static void check_dropped(void) {
+    printf("Records larger than the buffer:\n");
+    FILE* stream = tmpfile();
+    validation_sink_t sink;
+    check("CSV rejects a buffer smaller than its header",
+          validation_sink_open(&sink, VALIDATION_SINK_CSV, stream, 16) != 0);
+    check("text sink with a 40-byte buffer opens",
+          validation_sink_open(&sink, VALIDATION_SINK_TEXT, stream, 40) == 0);
+    
+    validation_record_t records[4] = {
+        make_record(0, "ok", true, 1.0f, 1.0f),
+        make_record(1, "a_test_name_far_too_long_to_fit", true, 1.0f, 1.0f),
+        make_record(2, "ok", false, 2.0f, 1.0f),
+        make_record(3, "another_test_name_too_long_here", true, 1.0f, 1.0f),
+    };
+    validation_sink_write(&sink, NULL, records, 4);
+    check("two dropped, two written", sink.dropped == 2 && sink.records == 2);
+    check("flush still succeeds", validation_sink_close(&sink) == 0);
+    
+    char text[256];
+    read_back(stream, text, sizeof(text));
+    check("only the records that fit reach the stream",
+          strcmp(text, "[PASS] ok: 1.000 (expected: 1.000)\n"
+                       "[FAIL] ok: 2.000 (expected: 1.000)\n") == 0);
+    fclose(stream);
+}
+
+// Through a context: partial batches, full batches, a buffer that drains
+// mid-batch, and explicit flushes in between must keep the stream in order
+static void check_order(void) {
+    printf("Order across batch and flush boundaries:\n");
+    FILE* stream = tmpfile();
+    validation_sink_t sink;
+    validation_ctx_t ctx;
+    const uint32_t total = VALIDATION_SINK_BATCH * 3 + 5;
+    
+    // Room for 10 records: the buffer drains several times per batch
+    validation_sink_open(&sink, VALIDATION_SINK_BINARY, stream,
+                         VALIDATION_BINARY_HEADER_SIZE + 10 * VALIDATION_BINARY_RECORD_SIZE);
+    validation_ctx_init(&ctx, "order");
+    validation_ctx_add_sink(&ctx, &sink);
+    
+    int flushes_ok = 1;
+    for (uint32_t i = 0; i < total; i++) {
+        log_test_result_ctx(&ctx, "step", (i % 3) != 0, (float)i, 0.0f);
+        if (i == 10 || i == VALIDATION_SINK_BATCH - 1 || i == VALIDATION_SINK_BATCH + 7) {
+            flushes_ok = flushes_ok && validation_ctx_flush(&ctx) == 0;
+        }
+    }
+    flushes_ok = flushes_ok && validation_ctx_flush(&ctx) == 0;
+    validation_ctx_remove_sinks(&ctx);
+    validation_sink_close(&sink);
+    check("flushes succeed", flushes_ok);
+    
+    rewind(stream);
+    unsigned char record[VALIDATION_BINARY_RECORD_SIZE];
+    uint32_t count = 0;
+    int in_order = 1;
+    if (fseek(stream, VALIDATION_BINARY_HEADER_SIZE, SEEK_SET) != 0) {
+        in_order = 0;
+    }
+    while (in_order && fread(record, 1, sizeof(record), stream) == sizeof(record)) {
+        uint64_t sequence;
+        float measured;
+        memcpy(&sequence, record, 8);
+        memcpy(&measured, record + 8, 4);
+        in_order = sequence == count && measured == (float)count &&
+                   load_u32(record + 16) == ((count % 3) != 0 ? 1u : 0u);
+        count++;
+    }
+    printf("  %u of %u records\n", (unsigned)count, (unsigned)total);
+    check("every record once, in sequence order", in_order && count == total);
+    fclose(stream);
+}
+
+int main(void) {
+    check_csv();
+    check_jsonl();
+    check_binary();
+    check_dropped();
+    check_order();
+    
+    if (failures) {
+        printf("%d sink check(s) FAILED\n", failures);
+        return 1;
+    }
+    printf("All sink checks passed\n");
+    return 0;
+}
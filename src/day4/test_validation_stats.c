@@ -0,0 +1,223 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "validation_lib.h"
+#include "validation_stats.h"
+
+// Streaming statistics against values known in closed form or published:
+//   - Welford mean and sample variance of 1..N, n(n+1)/12
+//   - P² on the 20-sample worked example of Jain & Chlamtac, nearest rank
+//     below five samples, and p50/p95/p99 of a shuffled ramp
+//   - Chan merge of two partial contexts against one pass over the union
+//   - params_dropped for a full table, over-long names and merges
+
+static int failures = 0;
+
+static void check(const char* what, int ok) {
+    printf("  %-48s %s\n", what, ok ? "OK" : "FAIL");
+    if (!ok) failures++;
+}
+
+static int close_to(double value, double expected, double tolerance) {
+    return fabs(value - expected) <= tolerance;
+}
+
+// 1..count in a fixed scrambled order (37 is coprime to every count used)
+static double ramp_value(uint32_t i, uint32_t count) {
+    return (double)((i * 37u) % count + 1u);
+}
+
+static void check_welford(void) {
+    printf("Welford mean and variance:\n");
+    validation_stats_t stats;
+    validation_stats_init(&stats);
+    check("empty: mean, variance and median 0",
+          validation_stats_mean(&stats) == 0.0 && validation_stats_variance(&stats) == 0.0 &&
+          validation_stats_quantile(&stats, VALIDATION_STATS_P50) == 0.0);
+    
+    const uint32_t count = 1000;
+    for (uint32_t i = 0; i < count; i++) {
+        validation_stats_add(&stats, ramp_value(i, count));
+    }
+    check("count, min and max exact",
+          stats.count == count && stats.min == 1.0 && stats.max == (double)count);
+    check("mean of 1..1000 is 500.5", close_to(validation_stats_mean(&stats), 500.5, 1e-9));
+    check("variance of 1..1000 is 83416.67",
+          close_to(validation_stats_variance(&stats), 1000.0 * 1001.0 / 12.0, 1e-6));
+    
+    // Large offset, tiny spread: the naive sum-of-squares formula loses it all
+    validation_stats_t offset;
+    validation_stats_init(&offset);
+    const double samples[4] = { 1e9 + 4.0, 1e9 + 7.0, 1e9 + 13.0, 1e9 + 16.0 };
+    for (int i = 0; i < 4; i++) {
+        validation_stats_add(&offset, samples[i]);
+    }
+    check("offset 1e9: variance 30 exactly", validation_stats_variance(&offset) == 30.0);
+}
+
+static void check_p2(void) {
+    printf("P² quantiles:\n");
+    // Jain & Chlamtac, CACM 28(10), 1985, table I. The paper's last rows
+    // carry an arithmetic slip and print 4.44; following its own formulas
+    // step by step gives markers 0.02, 0.15, 4.2462, 17.56, 38.62.
+    const double paper[20] = {
+        0.02, 0.5, 0.74, 3.39, 0.83, 22.37, 10.15, 15.43, 38.62, 15.92,
+        34.60, 10.28, 1.47, 0.40, 0.05, 11.39, 0.27, 0.42, 0.09, 11.37
+    };
+    validation_stats_t stats;
+    validation_stats_init(&stats);
+    for (int i = 0; i < 20; i++) {
+        validation_stats_add(&stats, paper[i]);
+    }
+    const validation_p2_t* median = &stats.quantiles[VALIDATION_STATS_P50];
+    printf("  markers %.2f %.2f %.2f %.2f %.2f\n", median->heights[0], median->heights[1],
+           median->heights[2], median->heights[3], median->heights[4]);
+    check("worked example median 4.2462",
+          close_to(validation_stats_quantile(&stats, VALIDATION_STATS_P50), 4.2462, 5e-5));
+    check("outer markers are the exact extremes",
+          median->heights[0] == 0.02 && median->heights[4] == 38.62);
+    check("marker positions 0, 5, 9, 15, 19",
+          median->positions[0] == 0 && median->positions[1] == 5 && median->positions[2] == 9 &&
+          median->positions[3] == 15 && median->positions[4] == 19);
+    
+    // Under five samples the raw values answer by nearest rank
+    validation_stats_t few;
+    validation_stats_init(&few);
+    validation_stats_add(&few, 30.0);
+    validation_stats_add(&few, 10.0);
+    validation_stats_add(&few, 20.0);
+    check("3 samples: p50 20, p99 30",
+          validation_stats_quantile(&few, VALIDATION_STATS_P50) == 20.0 &&
+          validation_stats_quantile(&few, VALIDATION_STATS_P99) == 30.0);
+    check("unknown quantile is 0",
+          validation_stats_quantile(&few, VALIDATION_STATS_QUANTILES) == 0.0);
+    
+    // Shuffled 1..10000: estimates within 1% of the range of the true ones
+    const uint32_t count = 10000;
+    validation_stats_t ramp;
+    validation_stats_init(&ramp);
+    for (uint32_t i = 0; i < count; i++) {
+        validation_stats_add(&ramp, ramp_value(i, count));
+    }
+    double p50 = validation_stats_quantile(&ramp, VALIDATION_STATS_P50);
+    double p95 = validation_stats_quantile(&ramp, VALIDATION_STATS_P95);
+    double p99 = validation_stats_quantile(&ramp, VALIDATION_STATS_P99);
+    printf("  1..%u: p50 %.1f, p95 %.1f, p99 %.1f\n", (unsigned)count, p50, p95, p99);
+    check("p50 near 5000", close_to(p50, 5000.5, 100.0));
+    check("p95 near 9500", close_to(p95, 9500.5, 100.0));
+    check("p99 near 9900", close_to(p99, 9900.5, 100.0));
+}
+
+static void check_merge(void) {
+    printf("Chan merge of partial contexts:\n");
+    validation_ctx_t whole, left, right;
+    validation_ctx_init(&whole, "whole");
+    validation_ctx_init(&left, "left");
+    validation_ctx_init(&right, "right");
+    
+    // Uneven split, different means on each side
+    const uint32_t count = 1000;
+    for (uint32_t i = 0; i < count; i++) {
+        float value = (float)ramp_value(i, count) / 8.0f;
+        record_test_result_ctx(&whole, "rail", i % 4 != 0, value);
+        record_test_result_ctx(value < 40.0f ? &left : &right, "rail", i % 4 != 0, value);
+    }
+    record_test_result_ctx(&right, "right_only", true, 2.5f);
+    validation_ctx_merge(&left, &right);
+    
+    const validation_stats_t* merged = validation_ctx_stats(&left, "rail");
+    const validation_stats_t* single = validation_ctx_stats(&whole, "rail");
+    check("totals add", validation_ctx_total(&left) == count + 1 &&
+          validation_ctx_passed(&left) == validation_ctx_passed(&whole) + 1);
+    check("both parameters present", merged && validation_ctx_stats(&left, "right_only"));
+    if (!merged || !single) {
+        return;
+    }
+    check("count, min and max exact",
+          merged->count == count && merged->min == single->min && merged->max == single->max);
+    check("mean matches one pass (62.5625)",
+          close_to(validation_stats_mean(merged), validation_stats_mean(single), 1e-9) &&
+          close_to(validation_stats_mean(merged), 62.5625, 1e-9));
+    check("variance matches one pass",
+          close_to(validation_stats_variance(merged), validation_stats_variance(single), 1e-7) &&
+          close_to(validation_stats_variance(merged), 1000.0 * 1001.0 / 12.0 / 64.0, 1e-7));
+    
+    // A side still under five samples is replayed one value at a time
+    validation_stats_t big, small;
+    validation_stats_init(&big);
+    validation_stats_init(&small);
+    for (int i = 1; i <= 3; i++) {
+        validation_stats_add(&small, (double)i);
+    }
+    for (int i = 4; i <= 8; i++) {
+        validation_stats_add(&big, (double)i);
+    }
+    validation_stats_merge(&small, &big);
+    check("small into big: 1..8, mean 4.5, variance 6",
+          small.count == 8 && small.min == 1.0 && small.max == 8.0 &&
+          close_to(validation_stats_mean(&small), 4.5, 1e-12) &&
+          close_to(validation_stats_variance(&small), 6.0, 1e-12));
+}
+
+static void check_dropped(void) {
+    printf("Dropped parameter names:\n");
+    validation_ctx_t ctx;
+    validation_ctx_init(&ctx, "dropped");
+    char name[VALIDATION_PARAM_NAME_LEN + 8];
+    
+    for (int i = 0; i < VALIDATION_MAX_PARAMETERS; i++) {
+        snprintf(name, sizeof(name), "param_%02d", i);
+        record_test_result_ctx(&ctx, name, true, 1.0f);
+    }
+    check("full table, none dropped",
+          ctx.param_count == VALIDATION_MAX_PARAMETERS && ctx.params_dropped == 0);
+    record_test_result_ctx(&ctx, "param_00", true, 2.0f);
+    check("existing name still tracked", ctx.params_dropped == 0);
+    record_test_result_ctx(&ctx, "one_too_many", true, 1.0f);
+    record_test_result_ctx(&ctx, "one_too_many", false, 1.0f);
+    check("each result past the table counted", ctx.params_dropped == 2);
+    check("results still counted in totals",
+          validation_ctx_total(&ctx) == VALIDATION_MAX_PARAMETERS + 3);
+    
+    validation_ctx_t names;
+    validation_ctx_init(&names, "names");
+    memset(name, 'n', sizeof(name));
+    name[VALIDATION_PARAM_NAME_LEN - 1] = '\0';
+    record_test_result_ctx(&names, name, true, 1.0f);
+    check("31-char name tracked", names.param_count == 1 && names.params_dropped == 0);
+    name[VALIDATION_PARAM_NAME_LEN - 1] = 'n';
+    name[VALIDATION_PARAM_NAME_LEN] = '\0';
+    record_test_result_ctx(&names, name, true, 1.0f);
+    check("32-char name dropped", names.param_count == 1 && names.params_dropped == 1);
+    
+    // Merging into the full table: src's drops plus every result of a new name
+    validation_ctx_t src;
+    validation_ctx_init(&src, "src");
+    record_test_result_ctx(&src, "param_05", true, 1.0f);
+    for (int i = 0; i < 3; i++) {
+        record_test_result_ctx(&src, "not_in_dst", true, 1.0f);
+    }
+    record_test_result_ctx(&src, name, true, 1.0f);
+    validation_ctx_merge(&ctx, &src);
+    check("merge: 2 + 1 + 3 dropped", ctx.params_dropped == 6);
+    check("merge: shared name gained its sample",
+          validation_ctx_stats(&ctx, "param_05")->count == 2);
+    
+    reset_test_counters_ctx(&ctx);
+    check("reset clears the count", ctx.params_dropped == 0);
+}
+
+int main(void) {
+    check_welford();
+    check_p2();
+    check_merge();
+    check_dropped();
+    
+    if (failures) {
+        printf("%d stats check(s) FAILED\n", failures);
+        return 1;
+    }
+    printf("All stats checks passed\n");
+    return 0;
+}
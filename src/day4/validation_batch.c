@@ -0,0 +1,295 @@
+#include "validation_lib.h"
+
+// Batch validators: one call screens a whole capture and returns the pass
+// count, optionally writing a pass bitmap (bit i % 8 of byte i / 8). Each
+// element gets exactly the verdict the scalar validator would give it.
+//
+// x86-64 hosts pick AVX2 or SSE2 at first use; everything else (including
+// the RISC-V target) runs the scalar loop.
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define VALIDATION_BATCH_X86 1
+#include <immintrin.h>
+#endif
+
+typedef size_t (*voltage_batch_fn)(const float*, size_t, float, float, uint8_t*);
+typedef size_t (*frequency_batch_fn)(const uint32_t*, size_t, uint32_t, uint32_t, uint8_t*);
+typedef size_t (*power_batch_fn)(const float*, const float*, size_t, float, uint8_t*);
+
+// Scalar tail shared by every path: finishes elements [start, n) and the
+// partially filled bitmap byte
+static size_t voltage_batch_tail(const float* measured, size_t start, size_t n,
+                                 float expected, float tolerance, uint8_t* pass_bitmap) {
+    size_t passed = 0;
+    uint8_t bits = 0;
+    
+    for (size_t i = start; i < n; i++) {
+        if (validate_voltage(measured[i], expected, tolerance)) {
+            bits |= (uint8_t)(1u << (i & 7));
+            passed++;
+        }
+        if ((i & 7) == 7 || i == n - 1) {
+            if (pass_bitmap) {
+                pass_bitmap[i >> 3] = bits;
+            }
+            bits = 0;
+        }
+    }
+    return passed;
+}
+
+static size_t frequency_batch_tail(const uint32_t* measured_hz, size_t start, size_t n,
+                                   uint32_t expected_hz, uint32_t tolerance_hz,
+                                   uint8_t* pass_bitmap) {
+    size_t passed = 0;
+    uint8_t bits = 0;
+    
+    for (size_t i = start; i < n; i++) {
+        if (validate_frequency(measured_hz[i], expected_hz, tolerance_hz)) {
+            bits |= (uint8_t)(1u << (i & 7));
+            passed++;
+        }
+        if ((i & 7) == 7 || i == n - 1) {
+            if (pass_bitmap) {
+                pass_bitmap[i >> 3] = bits;
+            }
+            bits = 0;
+        }
+    }
+    return passed;
+}
+
+static size_t power_batch_tail(const float* voltage, const float* current, size_t start,
+                               size_t n, float max_power, uint8_t* pass_bitmap) {
+    size_t passed = 0;
+    uint8_t bits = 0;
+    
+    for (size_t i = start; i < n; i++) {
+        if (validate_power(voltage[i], current[i], max_power)) {
+            bits |= (uint8_t)(1u << (i & 7));
+            passed++;
+        }
+        if ((i & 7) == 7 || i == n - 1) {
+            if (pass_bitmap) {
+                pass_bitmap[i >> 3] = bits;
+            }
+            bits = 0;
+        }
+    }
+    return passed;
+}
+
+static size_t voltage_batch_scalar(const float* measured, size_t n, float expected,
+                                   float tolerance, uint8_t* pass_bitmap) {
+    return voltage_batch_tail(measured, 0, n, expected, tolerance, pass_bitmap);
+}
+
+static size_t frequency_batch_scalar(const uint32_t* measured_hz, size_t n, uint32_t expected_hz,
+                                     uint32_t tolerance_hz, uint8_t* pass_bitmap) {
+    return frequency_batch_tail(measured_hz, 0, n, expected_hz, tolerance_hz, pass_bitmap);
+}
+
+static size_t power_batch_scalar(const float* voltage, const float* current, size_t n,
+                                 float max_power, uint8_t* pass_bitmap) {
+    return power_batch_tail(voltage, current, 0, n, max_power, pass_bitmap);
+}
+
+#ifdef VALIDATION_BATCH_X86
+
+// SSE2: two 4-lane compares per bitmap byte. |m - e| is exact either way
+// round, so clearing the sign bit matches the scalar branch; NaN compares
+// false and fails, as in validate_voltage().
+static size_t voltage_batch_sse2(const float* measured, size_t n, float expected,
+                                 float tolerance, uint8_t* pass_bitmap) {
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 exp_v = _mm_set1_ps(expected);
+    const __m128 tol_v = _mm_set1_ps(tolerance);
+    size_t passed = 0;
+    size_t i = 0;
+    
+    for (; i + 8 <= n; i += 8) {
+        __m128 lo = _mm_andnot_ps(sign, _mm_sub_ps(_mm_loadu_ps(measured + i), exp_v));
+        __m128 hi = _mm_andnot_ps(sign, _mm_sub_ps(_mm_loadu_ps(measured + i + 4), exp_v));
+        unsigned bits = (unsigned)_mm_movemask_ps(_mm_cmple_ps(lo, tol_v)) |
+                        ((unsigned)_mm_movemask_ps(_mm_cmple_ps(hi, tol_v)) << 4);
+        if (pass_bitmap) {
+            pass_bitmap[i >> 3] = (uint8_t)bits;
+        }
+        passed += (size_t)__builtin_popcount(bits);
+    }
+    return passed + voltage_batch_tail(measured, i, n, expected, tolerance, pass_bitmap);
+}
+
+// SSE2 has no unsigned 32-bit compare: flip the sign bit and compare signed
+static inline __m128i abs_diff_u32_sse2(__m128i a, __m128i b, __m128i bias) {
+    __m128i a_gt_b = _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+    return _mm_or_si128(_mm_and_si128(a_gt_b, _mm_sub_epi32(a, b)),
+                        _mm_andnot_si128(a_gt_b, _mm_sub_epi32(b, a)));
+}
+
+static inline unsigned le_u32_mask_sse2(__m128i diff, __m128i tol_biased, __m128i bias) {
+    __m128i over = _mm_cmpgt_epi32(_mm_xor_si128(diff, bias), tol_biased);
+    return (unsigned)_mm_movemask_ps(_mm_castsi128_ps(over)) ^ 0xFu;
+}
+
+static size_t frequency_batch_sse2(const uint32_t* measured_hz, size_t n, uint32_t expected_hz,
+                                   uint32_t tolerance_hz, uint8_t* pass_bitmap) {
+    const __m128i bias = _mm_set1_epi32((int32_t)0x80000000u);
+    const __m128i exp_v = _mm_set1_epi32((int32_t)expected_hz);
+    const __m128i tol_biased = _mm_xor_si128(_mm_set1_epi32((int32_t)tolerance_hz), bias);
+    size_t passed = 0;
+    size_t i = 0;
+    
+    for (; i + 8 <= n; i += 8) {
+        __m128i lo = _mm_loadu_si128((const __m128i*)(measured_hz + i));
+        __m128i hi = _mm_loadu_si128((const __m128i*)(measured_hz + i + 4));
+        unsigned bits = le_u32_mask_sse2(abs_diff_u32_sse2(lo, exp_v, bias), tol_biased, bias) |
+                        (le_u32_mask_sse2(abs_diff_u32_sse2(hi, exp_v, bias), tol_biased, bias) << 4);
+        if (pass_bitmap) {
+            pass_bitmap[i >> 3] = (uint8_t)bits;
+        }
+        passed += (size_t)__builtin_popcount(bits);
+    }
+    return passed + frequency_batch_tail(measured_hz, i, n, expected_hz, tolerance_hz, pass_bitmap);
+}
+
+static size_t power_batch_sse2(const float* voltage, const float* current, size_t n,
+                               float max_power, uint8_t* pass_bitmap) {
+    const __m128 max_v = _mm_set1_ps(max_power);
+    size_t passed = 0;
+    size_t i = 0;
+    
+    for (; i + 8 <= n; i += 8) {
+        __m128 lo = _mm_mul_ps(_mm_loadu_ps(voltage + i), _mm_loadu_ps(current + i));
+        __m128 hi = _mm_mul_ps(_mm_loadu_ps(voltage + i + 4), _mm_loadu_ps(current + i + 4));
+        unsigned bits = (unsigned)_mm_movemask_ps(_mm_cmple_ps(lo, max_v)) |
+                        ((unsigned)_mm_movemask_ps(_mm_cmple_ps(hi, max_v)) << 4);
+        if (pass_bitmap) {
+            pass_bitmap[i >> 3] = (uint8_t)bits;
+        }
+        passed += (size_t)__builtin_popcount(bits);
+    }
+    return passed + power_batch_tail(voltage, current, i, n, max_power, pass_bitmap);
+}
+
+// AVX2: one 8-lane compare per bitmap byte
+__attribute__((target("avx2")))
+static size_t voltage_batch_avx2(const float* measured, size_t n, float expected,
+                                 float tolerance, uint8_t* pass_bitmap) {
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 exp_v = _mm256_set1_ps(expected);
+    const __m256 tol_v = _mm256_set1_ps(tolerance);
+    size_t passed = 0;
+    size_t i = 0;
+    
+    for (; i + 8 <= n; i += 8) {
+        __m256 diff = _mm256_andnot_ps(sign, _mm256_sub_ps(_mm256_loadu_ps(measured + i), exp_v));
+        unsigned bits = (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(diff, tol_v, _CMP_LE_OQ));
+        if (pass_bitmap) {
+            pass_bitmap[i >> 3] = (uint8_t)bits;
+        }
+        passed += (size_t)__builtin_popcount(bits);
+    }
+    return passed + voltage_batch_tail(measured, i, n, expected, tolerance, pass_bitmap);
+}
+
+__attribute__((target("avx2")))
+static size_t frequency_batch_avx2(const uint32_t* measured_hz, size_t n, uint32_t expected_hz,
+                                   uint32_t tolerance_hz, uint8_t* pass_bitmap) {
+    const __m256i exp_v = _mm256_set1_epi32((int32_t)expected_hz);
+    const __m256i tol_v = _mm256_set1_epi32((int32_t)tolerance_hz);
+    size_t passed = 0;
+    size_t i = 0;
+    
+    for (; i + 8 <= n; i += 8) {
+        __m256i m = _mm256_loadu_si256((const __m256i*)(measured_hz + i));
+        __m256i diff = _mm256_sub_epi32(_mm256_max_epu32(m, exp_v), _mm256_min_epu32(m, exp_v));
+        // diff <= tol exactly when min(diff, tol) == diff
+        __m256i ok = _mm256_cmpeq_epi32(_mm256_min_epu32(diff, tol_v), diff);
+        unsigned bits = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(ok));
+        if (pass_bitmap) {
+            pass_bitmap[i >> 3] = (uint8_t)bits;
+        }
+        passed += (size_t)__builtin_popcount(bits);
+    }
+    return passed + frequency_batch_tail(measured_hz, i, n, expected_hz, tolerance_hz, pass_bitmap);
+}
+
+__attribute__((target("avx2")))
+static size_t power_batch_avx2(const float* voltage, const float* current, size_t n,
+                               float max_power, uint8_t* pass_bitmap) {
+    const __m256 max_v = _mm256_set1_ps(max_power);
+    size_t passed = 0;
+    size_t i = 0;
+    
+    for (; i + 8 <= n; i += 8) {
+        __m256 power = _mm256_mul_ps(_mm256_loadu_ps(voltage + i), _mm256_loadu_ps(current + i));
+        unsigned bits = (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(power, max_v, _CMP_LE_OQ));
+        if (pass_bitmap) {
+            pass_bitmap[i >> 3] = (uint8_t)bits;
+        }
+        passed += (size_t)__builtin_popcount(bits);
+    }
+    return passed + power_batch_tail(voltage, current, i, n, max_power, pass_bitmap);
+}
+
+#endif // VALIDATION_BATCH_X86
+
+static voltage_batch_fn voltage_batch_impl = 0;
+static frequency_batch_fn frequency_batch_impl = 0;
+static power_batch_fn power_batch_impl = 0;
+static const char* batch_isa = "scalar";
+
+// Every thread resolves to the same pointers, so a racing first call is harmless
+static void validation_batch_resolve(void) {
+    voltage_batch_impl = voltage_batch_scalar;
+    frequency_batch_impl = frequency_batch_scalar;
+    power_batch_impl = power_batch_scalar;
+    batch_isa = "scalar";
+    
+#ifdef VALIDATION_BATCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        voltage_batch_impl = voltage_batch_avx2;
+        frequency_batch_impl = frequency_batch_avx2;
+        power_batch_impl = power_batch_avx2;
+        batch_isa = "avx2";
+    } else {
+        voltage_batch_impl = voltage_batch_sse2;
+        frequency_batch_impl = frequency_batch_sse2;
+        power_batch_impl = power_batch_sse2;
+        batch_isa = "sse2";
+    }
+#endif
+}
+
+size_t validate_voltage_batch(const float* measured, size_t n, float expected,
+                              float tolerance, uint8_t* pass_bitmap) {
+    if (!voltage_batch_impl) {
+        validation_batch_resolve();
+    }
+    return voltage_batch_impl(measured, n, expected, tolerance, pass_bitmap);
+}
+
+size_t validate_frequency_batch(const uint32_t* measured_hz, size_t n, uint32_t expected_hz,
+                                uint32_t tolerance_hz, uint8_t* pass_bitmap) {
+    if (!frequency_batch_impl) {
+        validation_batch_resolve();
+    }
+    return frequency_batch_impl(measured_hz, n, expected_hz, tolerance_hz, pass_bitmap);
+}
+
+size_t validate_power_batch(const float* voltage, const float* current, size_t n,
+                            float max_power, uint8_t* pass_bitmap) {
+    if (!power_batch_impl) {
+        validation_batch_resolve();
+    }
+    return power_batch_impl(voltage, current, n, max_power, pass_bitmap);
+}
+
+const char* validation_batch_isa(void) {
+    if (!voltage_batch_impl) {
+        validation_batch_resolve();
+    }
+    return batch_isa;
+}
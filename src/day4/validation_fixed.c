@@ -0,0 +1,42 @@
+#include "validation_fixed.h"
+
+// Differences are taken in 64 bits so extreme inputs cannot wrap
+
+bool validate_voltage_mv(int32_t measured_mv, int32_t expected_mv, int32_t tolerance_mv) {
+    int64_t diff = (int64_t)measured_mv - expected_mv;
+    if (diff < 0) {
+        diff = -diff;
+    }
+    return diff <= tolerance_mv;
+}
+
+// mV x uA = nW, compared against the limit scaled to nW
+bool validate_power_mv_ua(int32_t voltage_mv, int32_t current_ua, int32_t max_power_uw) {
+    int64_t power_nw = (int64_t)voltage_mv * current_ua;
+    return power_nw <= (int64_t)max_power_uw * 1000;
+}
+
+bool validate_voltage_q16(q16_16_t measured, q16_16_t expected, q16_16_t tolerance) {
+    int64_t diff = (int64_t)measured - expected;
+    if (diff < 0) {
+        diff = -diff;
+    }
+    return diff <= tolerance;
+}
+
+// The Q32.32 product is compared exactly, with no intermediate rounding
+bool validate_power_q16(q16_16_t voltage, q16_16_t current, q16_16_t max_power) {
+    int64_t power = (int64_t)voltage * current;
+    return power <= (int64_t)max_power * Q16_ONE;
+}
+
+int32_t adc_to_millivolts(uint16_t adc_value) {
+    return (int32_t)(((uint32_t)adc_value * VALIDATION_ADC_VREF_MV +
+                      VALIDATION_ADC_FULL_SCALE / 2) / VALIDATION_ADC_FULL_SCALE);
+}
+
+q16_16_t adc_to_q16(uint16_t adc_value) {
+    const int64_t denominator = (int64_t)VALIDATION_ADC_FULL_SCALE * 1000;
+    return (q16_16_t)(((int64_t)adc_value * VALIDATION_ADC_VREF_MV * Q16_ONE + denominator / 2) /
+                      denominator);
+}
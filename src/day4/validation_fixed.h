@@ -0,0 +1,44 @@
+#ifndef VALIDATION_FIXED_H
+#define VALIDATION_FIXED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Integer validation path for cores without an FPU. rv32imac has no F
+// extension, so every float compare, multiply and divide in the float API
+// is a soft-float library call; these variants use integer math only.
+//   - millivolts / microamps: exact decimal units, power in nW via 64-bit
+//   - Q16.16: binary fixed point, the same grid float represents exactly
+//
+// VALIDATION_FIXED_POINT is 1 on RISC-V builds without hardware float
+// (__riscv_flen undefined) and 0 elsewhere; define it to override.
+
+#ifndef VALIDATION_FIXED_POINT
+#if defined(__riscv) && !defined(__riscv_flen)
+#define VALIDATION_FIXED_POINT 1
+#else
+#define VALIDATION_FIXED_POINT 0
+#endif
+#endif
+
+// 12-bit ADC on a 3.3 V reference
+#define VALIDATION_ADC_VREF_MV    3300
+#define VALIDATION_ADC_FULL_SCALE 4095
+
+typedef int32_t q16_16_t;
+
+#define Q16_ONE              ((q16_16_t)0x10000)
+#define Q16_FROM_INT(value)  ((q16_16_t)((value) * Q16_ONE))
+#define Q16_FROM_MV(mv)      ((q16_16_t)(((int64_t)(mv) * Q16_ONE + 500) / 1000))
+
+bool validate_voltage_mv(int32_t measured_mv, int32_t expected_mv, int32_t tolerance_mv);
+bool validate_power_mv_ua(int32_t voltage_mv, int32_t current_ua, int32_t max_power_uw);
+
+bool validate_voltage_q16(q16_16_t measured, q16_16_t expected, q16_16_t tolerance);
+bool validate_power_q16(q16_16_t voltage, q16_16_t current, q16_16_t max_power);
+
+// ADC code to voltage, rounded to nearest
+int32_t adc_to_millivolts(uint16_t adc_value);
+q16_16_t adc_to_q16(uint16_t adc_value);
+
+#endif // VALIDATION_FIXED_H
@@ -1,9 +1,73 @@
 #include "validation_lib.h"
+#include "limits_table.h"
 #include <stdio.h>
+#include <string.h>
 
-// Global test statistics
-static int total_tests = 0;
-static int passed_tests = 0;
+// Default context behind the original global API
+static validation_ctx_t default_ctx;
+
+void validation_ctx_init(validation_ctx_t* ctx, const char* name) {
+    ctx->name = name;
+    ctx->sink_count = 0;
+    ctx->pending_count = 0;
+    ctx->sequence = 0;
+    ctx->dispatch_next = 0;
+    ctx->dispatch_serving = 0;
+    __atomic_clear(&ctx->lock, __ATOMIC_RELAXED);
+    reset_test_counters_ctx(ctx);
+}
+
+static void ctx_acquire(validation_ctx_t* ctx) {
+    while (__atomic_test_and_set(&ctx->lock, __ATOMIC_ACQUIRE)) {
+    }
+}
+
+static void ctx_release(validation_ctx_t* ctx) {
+    __atomic_clear(&ctx->lock, __ATOMIC_RELEASE);
+}
+
+// Caller holds the lock
+static validation_param_t* params_find(const validation_ctx_t* ctx, const char* test_name) {
+    for (uint32_t i = 0; i < ctx->param_count; i++) {
+        if (strcmp(ctx->params[i].name, test_name) == 0) {
+            return (validation_param_t*)&ctx->params[i];
+        }
+    }
+    return NULL;
+}
+
+// NULL when the table is full or the name is too long to store: a truncated
+// key would merge distinct tests that share a prefix
+static validation_param_t* params_find_or_add(validation_ctx_t* ctx, const char* test_name) {
+    size_t length = 0;
+    while (length < VALIDATION_PARAM_NAME_LEN && test_name[length]) length++;
+    if (length == VALIDATION_PARAM_NAME_LEN) return NULL;
+    
+    validation_param_t* param = params_find(ctx, test_name);
+    if (param || ctx->param_count >= VALIDATION_MAX_PARAMETERS) {
+        return param;
+    }
+    
+    param = &ctx->params[ctx->param_count++];
+    memcpy(param->name, test_name, length + 1);
+    validation_stats_init(&param->stats);
+    return param;
+}
+
+validation_ctx_t* validation_default_ctx(void) {
+    return &default_ctx;
+}
+
+uint32_t validation_ctx_total(const validation_ctx_t* ctx) {
+    return __atomic_load_n(&ctx->total_tests, __ATOMIC_ACQUIRE);
+}
+
+// A logger may be between its two increments; never report more passes than tests
+uint32_t validation_ctx_passed(const validation_ctx_t* ctx) {
+    uint32_t passed = __atomic_load_n(&ctx->passed_tests, __ATOMIC_ACQUIRE);
+    uint32_t total = validation_ctx_total(ctx);
+    return (passed > total) ? total : passed;
+}
 
 bool validate_voltage(float measured, float expected, float tolerance) {
     float diff = (measured > expected) ? (measured - expected) : (expected - measured);
@@ -16,60 +80,279 @@ bool validate_frequency(uint32_t measured_hz, uint32_t expected_hz, uint32_t tol
     return (diff <= tolerance_hz);
 }
 
+// floor(expected * ppm / 1e6) split so nothing overflows while ppm <= 1e6;
+// diff <= floor(x) is exact for an integer diff
+bool validate_frequency_ppm(uint64_t measured_hz, uint64_t expected_hz, uint32_t tolerance_ppm) {
+    const uint64_t million = 1000000u;
+    uint64_t ppm = tolerance_ppm > million ? million : tolerance_ppm;
+    uint64_t allowed = (expected_hz / million) * ppm + (expected_hz % million) * ppm / million;
+    
+    uint64_t diff = (measured_hz > expected_hz) ?
+                    (measured_hz - expected_hz) : (expected_hz - measured_hz);
+    return (diff <= allowed);
+}
+
+int64_t frequency_error_ppm(uint64_t measured_hz, uint64_t expected_hz) {
+    if (expected_hz == 0) return 0;
+    
+    const uint64_t million = 1000000u;
+    uint64_t diff = (measured_hz > expected_hz) ?
+                    (measured_hz - expected_hz) : (expected_hz - measured_hz);
+    uint64_t ppm = (diff / expected_hz) * million + (diff % expected_hz) * million / expected_hz;
+    if (ppm > INT64_MAX) ppm = INT64_MAX;
+    return (measured_hz >= expected_hz) ? (int64_t)ppm : -(int64_t)ppm;
+}
+
 bool validate_power(float voltage, float current, float max_power) {
     float calculated_power = voltage * current;
     return (calculated_power <= max_power);
 }
 
-void log_test_result(const char* test_name, bool passed, float measured, float expected) {
-    total_tests++;
+static bool limits_within(const limits_t* limits, double measured) {
+    return measured >= limits->lo && measured <= limits->hi;
+}
+
+bool validate_limits(const char* test_id, double measured) {
+    limits_t limits;
+    return limits_lookup(test_id, &limits) && limits_within(&limits, measured);
+}
+
+// Spec-sheet limits replace the built-in ones when a table has the test
+static bool suite_check(const char* test_id, bool builtin_result, double measured) {
+    limits_t limits;
+    return limits_lookup(test_id, &limits) ? limits_within(&limits, measured) : builtin_result;
+}
+
+void record_test_result_ctx(validation_ctx_t* ctx, const char* test_name, bool passed,
+                            float measured) {
+    // passed_tests first, so a concurrent reader never sees more passes than tests
     if (passed) {
-        passed_tests++;
-        printf("[PASS] %s: %.3f (expected: %.3f)\n", test_name, measured, expected);
+        __atomic_fetch_add(&ctx->passed_tests, 1, __ATOMIC_RELEASE);
+    }
+    __atomic_fetch_add(&ctx->total_tests, 1, __ATOMIC_RELEASE);
+    
+    ctx_acquire(ctx);
+    validation_param_t* param = params_find_or_add(ctx, test_name);
+    if (param) {
+        validation_stats_add(&param->stats, measured);
     } else {
-        printf("[FAIL] %s: %.3f (expected: %.3f)\n", test_name, measured, expected);
+        ctx->params_dropped++;
     }
+    ctx_release(ctx);
 }
 
-void print_test_summary(void) {
-    printf("\n=== Test Summary ===\n");
-    printf("Total Tests: %d\n", total_tests);
-    printf("Passed: %d\n", passed_tests);
-    printf("Failed: %d\n", total_tests - passed_tests);
+// Caller holds the lock; it is released once the batch is taken, so sink
+// formatting and I/O never run under it. Batches are tickets served in the
+// order taken, so sinks still see records in sequence order.
+static int ctx_dispatch(validation_ctx_t* ctx, bool flush) {
+    validation_record_t records[VALIDATION_SINK_BATCH];
+    validation_sink_t* sinks[VALIDATION_MAX_SINKS];
+    uint32_t count = ctx->pending_count;
+    uint32_t sink_count = ctx->sink_count;
+    uint32_t ticket = ctx->dispatch_next++;
+    int status = 0;
+    
+    memcpy(records, ctx->pending, count * sizeof(records[0]));
+    memcpy(sinks, ctx->sinks, sink_count * sizeof(sinks[0]));
+    ctx->pending_count = 0;
+    ctx_release(ctx);
+    
+    while (__atomic_load_n(&ctx->dispatch_serving, __ATOMIC_ACQUIRE) != ticket) {
+    }
+    for (uint32_t i = 0; i < sink_count; i++) {
+        validation_sink_write(sinks[i], ctx->name, records, count);
+        if (flush && validation_sink_flush(sinks[i]) != 0) {
+            status = -1;
+        }
+    }
+    __atomic_store_n(&ctx->dispatch_serving, ticket + 1, __ATOMIC_RELEASE);
+    return status;
+}
+
+void log_test_result_ctx(validation_ctx_t* ctx, const char* test_name, bool passed,
+                         float measured, float expected) {
+    record_test_result_ctx(ctx, test_name, passed, measured);
+    
+    if (ctx->sink_count == 0) {
+        printf("%s%s%s[%s] %s: %.3f (expected: %.3f)\n",
+               ctx->name ? "[" : "", ctx->name ? ctx->name : "", ctx->name ? "] " : "",
+               passed ? "PASS" : "FAIL", test_name, measured, expected);
+        return;
+    }
+    
+    // Hot path: capture only; formatting happens in the sinks per batch
+    ctx_acquire(ctx);
+    validation_record_t* record = &ctx->pending[ctx->pending_count++];
+    record->sequence = ctx->sequence++;
+    record->measured = measured;
+    record->expected = expected;
+    record->passed = passed;
+    strncpy(record->test_name, test_name, VALIDATION_RECORD_NAME_LEN - 1);
+    record->test_name[VALIDATION_RECORD_NAME_LEN - 1] = '\0';
+    if (ctx->pending_count == VALIDATION_SINK_BATCH) {
+        ctx_dispatch(ctx, false);
+        return;
+    }
+    ctx_release(ctx);
+}
+
+int validation_ctx_add_sink(validation_ctx_t* ctx, validation_sink_t* sink) {
+    int status = -1;
+    
+    ctx_acquire(ctx);
+    if (ctx->sink_count < VALIDATION_MAX_SINKS) {
+        ctx->sinks[ctx->sink_count++] = sink;
+        status = 0;
+    }
+    ctx_release(ctx);
+    return status;
+}
+
+void validation_ctx_remove_sinks(validation_ctx_t* ctx) {
+    validation_ctx_flush(ctx);
+    
+    ctx_acquire(ctx);
+    ctx->sink_count = 0;
+    ctx_release(ctx);
+}
+
+int validation_ctx_flush(validation_ctx_t* ctx) {
+    ctx_acquire(ctx);
+    return ctx_dispatch(ctx, true);
+}
+
+// Not synchronized against writers: read once logging has finished
+const validation_stats_t* validation_ctx_stats(const validation_ctx_t* ctx, const char* test_name) {
+    validation_param_t* param = params_find(ctx, test_name);
+    return param ? &param->stats : NULL;
+}
+
+// Fold a worker's context into dst; src must no longer be written to
+void validation_ctx_merge(validation_ctx_t* dst, const validation_ctx_t* src) {
+    __atomic_fetch_add(&dst->passed_tests, validation_ctx_passed(src), __ATOMIC_RELEASE);
+    __atomic_fetch_add(&dst->total_tests, validation_ctx_total(src), __ATOMIC_RELEASE);
+    
+    ctx_acquire(dst);
+    dst->params_dropped += src->params_dropped;
+    for (uint32_t i = 0; i < src->param_count; i++) {
+        validation_param_t* param = params_find_or_add(dst, src->params[i].name);
+        if (param) {
+            validation_stats_merge(&param->stats, &src->params[i].stats);
+        } else {
+            dst->params_dropped += (uint32_t)src->params[i].stats.count;
+        }
+    }
+    ctx_release(dst);
+}
+
+static void print_distributions(const validation_ctx_t* ctx) {
+    if (ctx->param_count == 0) {
+        return;
+    }
+    
+    printf("\n--- Measurement Distributions ---\n");
+    printf("%-24s %10s %10s %10s %10s %10s %10s %10s %10s\n", "Parameter", "Count", "Mean",
+           "StdDev", "Min", "P50", "P95", "P99", "Max");
+    for (uint32_t i = 0; i < ctx->param_count; i++) {
+        const validation_stats_t* stats = &ctx->params[i].stats;
+        printf("%-24s %10llu %10.4f %10.4f %10.4f %10.4f %10.4f %10.4f %10.4f\n",
+               ctx->params[i].name, (unsigned long long)stats->count,
+               validation_stats_mean(stats), validation_stats_stddev(stats), stats->min,
+               validation_stats_quantile(stats, VALIDATION_STATS_P50),
+               validation_stats_quantile(stats, VALIDATION_STATS_P95),
+               validation_stats_quantile(stats, VALIDATION_STATS_P99), stats->max);
+    }
+    if (ctx->params_dropped > 0) {
+        printf("(%u results not tracked: more than %d parameters or name over %d chars)\n",
+               (unsigned)ctx->params_dropped, VALIDATION_MAX_PARAMETERS,
+               VALIDATION_PARAM_NAME_LEN - 1);
+    }
+}
+
+void print_test_summary_ctx(validation_ctx_t* ctx) {
+    // Buffered results belong before the summary
+    validation_ctx_flush(ctx);
+    
+    uint32_t total = validation_ctx_total(ctx);
+    uint32_t passed = validation_ctx_passed(ctx);
+    
+    if (ctx->name) {
+        printf("\n=== Test Summary: %s ===\n", ctx->name);
+    } else {
+        printf("\n=== Test Summary ===\n");
+    }
+    printf("Total Tests: %u\n", (unsigned)total);
+    printf("Passed: %u\n", (unsigned)passed);
+    printf("Failed: %u\n", (unsigned)(total - passed));
     printf("Success Rate: %.1f%%\n", 
-           total_tests > 0 ? (float)passed_tests / total_tests * 100.0f : 0.0f);
+           total > 0 ? (float)passed / total * 100.0f : 0.0f);
+    
+    print_distributions(ctx);
+}
+
+void reset_test_counters_ctx(validation_ctx_t* ctx) {
+    __atomic_store_n(&ctx->total_tests, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&ctx->passed_tests, 0, __ATOMIC_RELAXED);
+    
+    ctx_acquire(ctx);
+    ctx->param_count = 0;
+    ctx->params_dropped = 0;
+    ctx_release(ctx);
+}
+
+void log_test_result(const char* test_name, bool passed, float measured, float expected) {
+    log_test_result_ctx(&default_ctx, test_name, passed, measured, expected);
+}
+
+void record_test_result(const char* test_name, bool passed, float measured) {
+    record_test_result_ctx(&default_ctx, test_name, passed, measured);
+}
+
+void print_test_summary(void) {
+    print_test_summary_ctx(&default_ctx);
 }
 
 void reset_test_counters(void) {
-    total_tests = 0;
-    passed_tests = 0;
+    reset_test_counters_ctx(&default_ctx);
 }
 
-int run_validation_suite(void) {
+int run_validation_suite_ctx(validation_ctx_t* ctx) {
     printf("FPGA Validation Test Suite\n");
     printf("==========================\n");
     
-    reset_test_counters();
+    reset_test_counters_ctx(ctx);
+    
+    if (limits_loaded()) {
+        printf("Using limits table revision %u (%u limits)\n",
+               (unsigned)limits_revision(), (unsigned)limits_count());
+    }
     
     // Voltage validation tests
-    bool result1 = validate_voltage(3.25f, 3.30f, 0.10f);
-    log_test_result("Core Voltage", result1, 3.25f, 3.30f);
+    bool result1 = suite_check("core_voltage", validate_voltage(3.25f, 3.30f, 0.10f), 3.25f);
+    log_test_result_ctx(ctx, "Core Voltage", result1, 3.25f, 3.30f);
     
-    bool result2 = validate_voltage(1.85f, 1.80f, 0.05f);
-    log_test_result("IO Voltage", result2, 1.85f, 1.80f);
+    bool result2 = suite_check("io_voltage", validate_voltage(1.85f, 1.80f, 0.05f), 1.85f);
+    log_test_result_ctx(ctx, "IO Voltage", result2, 1.85f, 1.80f);
     
     // Frequency validation tests
-    bool result3 = validate_frequency(99800000, 100000000, 500000);
-    log_test_result("Clock Frequency", result3, 99.8f, 100.0f);
+    bool result3 = suite_check("clock_frequency",
+                               validate_frequency(99800000, 100000000, 500000), 99800000.0);
+    log_test_result_ctx(ctx, "Clock Frequency", result3, 99.8f, 100.0f);
     
-    bool result4 = validate_frequency(50200000, 50000000, 100000);
-    log_test_result("Bus Frequency", result4, 50.2f, 50.0f);
+    bool result4 = suite_check("bus_frequency",
+                               validate_frequency(50200000, 50000000, 100000), 50200000.0);
+    log_test_result_ctx(ctx, "Bus Frequency", result4, 50.2f, 50.0f);
     
     // Power validation tests
-    bool result5 = validate_power(3.3f, 1.2f, 4.0f);
-    log_test_result("Power Consumption", result5, 3.96f, 4.0f);
+    bool result5 = suite_check("power_consumption", validate_power(3.3f, 1.2f, 4.0f),
+                               3.3f * 1.2f);
+    log_test_result_ctx(ctx, "Power Consumption", result5, 3.96f, 4.0f);
     
-    print_test_summary();
+    print_test_summary_ctx(ctx);
     
-    return (passed_tests == total_tests) ? 0 : 1;
+    return (validation_ctx_passed(ctx) == validation_ctx_total(ctx)) ? 0 : 1;
+}
+
+int run_validation_suite(void) {
+    return run_validation_suite_ctx(&default_ctx);
 }
\ No newline at end of file
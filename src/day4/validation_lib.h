@@ -3,18 +3,103 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include "validation_stats.h"
+#include "validation_fixed.h"
+#include "validation_sink.h"
 
 // Validation function prototypes
 bool validate_voltage(float measured, float expected, float tolerance);
 bool validate_frequency(uint32_t measured_hz, uint32_t expected_hz, uint32_t tolerance_hz);
 bool validate_power(float voltage, float current, float max_power);
 
-// Test logging functions
+// 64-bit frequency checks with ppm tolerances, for counter readings
+// (hal_freq_measure()) and clocks above 4.29 GHz. Any unit works as long as
+// measured and expected agree, e.g. millihertz for sub-hertz references.
+// Tolerances above 1000000 ppm are treated as 1000000.
+bool validate_frequency_ppm(uint64_t measured_hz, uint64_t expected_hz, uint32_t tolerance_ppm);
+int64_t frequency_error_ppm(uint64_t measured_hz, uint64_t expected_hz);  // Rounded toward zero
+
+// Check against the loaded limits table (limits_table.h): lo <= measured <= hi.
+// A test ID missing from the table fails.
+bool validate_limits(const char* test_id, double measured);
+
+// Batch validators: screen n measurements in one call and return the pass
+// count. pass_bitmap (may be NULL) receives (n + 7) / 8 bytes, bit i % 8 of
+// byte i / 8 set when element i passes. Vectorized (AVX2/SSE2) on x86-64.
+size_t validate_voltage_batch(const float* measured, size_t n, float expected,
+                              float tolerance, uint8_t* pass_bitmap);
+size_t validate_frequency_batch(const uint32_t* measured_hz, size_t n, uint32_t expected_hz,
+                                uint32_t tolerance_hz, uint8_t* pass_bitmap);
+size_t validate_power_batch(const float* voltage, const float* current, size_t n,
+                            float max_power, uint8_t* pass_bitmap);
+const char* validation_batch_isa(void);
+
+// Per-parameter distributions, keyed by test name
+#define VALIDATION_MAX_PARAMETERS 32
+#define VALIDATION_PARAM_NAME_LEN VALIDATION_RECORD_NAME_LEN
+
+// Result sinks per context, and records captured between sink batches
+#define VALIDATION_MAX_SINKS  4
+#define VALIDATION_SINK_BATCH 64
+
+typedef struct {
+    char name[VALIDATION_PARAM_NAME_LEN];
+    validation_stats_t stats;
+} validation_param_t;
+
+// Validation context: one per suite run (board, thread, ...). Counters are
+// updated atomically and the parameter table and record batch under a
+// spinlock, so threads may log into a shared context. The plain functions
+// below use a process-wide default context.
+//
+// A context without sinks prints each logged result with printf. Once sinks
+// are attached, log_test_result only captures a record; records reach the
+// sinks in batches of VALIDATION_SINK_BATCH and on validation_ctx_flush(),
+// formatted and written outside the context lock.
+typedef struct {
+    const char* name;           // Prefixed to log lines when not NULL
+    uint32_t total_tests;
+    uint32_t passed_tests;
+    uint32_t param_count;
+    uint32_t params_dropped;    // Results with no table slot or too long a name
+    uint8_t lock;
+    validation_param_t params[VALIDATION_MAX_PARAMETERS];
+    validation_sink_t* sinks[VALIDATION_MAX_SINKS];
+    uint32_t sink_count;
+    uint32_t pending_count;
+    uint64_t sequence;
+    uint32_t dispatch_next;     // Batch tickets: taken under the lock,
+    uint32_t dispatch_serving;  // served in order outside it
+    validation_record_t pending[VALIDATION_SINK_BATCH];
+} validation_ctx_t;
+
+void validation_ctx_init(validation_ctx_t* ctx, const char* name);
+validation_ctx_t* validation_default_ctx(void);
+uint32_t validation_ctx_total(const validation_ctx_t* ctx);
+uint32_t validation_ctx_passed(const validation_ctx_t* ctx);
+
+void log_test_result_ctx(validation_ctx_t* ctx, const char* test_name, bool passed,
+                         float measured, float expected);
+void record_test_result_ctx(validation_ctx_t* ctx, const char* test_name, bool passed,
+                            float measured);
+const validation_stats_t* validation_ctx_stats(const validation_ctx_t* ctx, const char* test_name);
+void validation_ctx_merge(validation_ctx_t* dst, const validation_ctx_t* src);
+// Attach sinks before logging starts; the context does not own them
+int validation_ctx_add_sink(validation_ctx_t* ctx, validation_sink_t* sink);
+void validation_ctx_remove_sinks(validation_ctx_t* ctx);
+int validation_ctx_flush(validation_ctx_t* ctx);
+void print_test_summary_ctx(validation_ctx_t* ctx);
+void reset_test_counters_ctx(validation_ctx_t* ctx);
+int run_validation_suite_ctx(validation_ctx_t* ctx);
+
+// Test logging functions (default context)
 void log_test_result(const char* test_name, bool passed, float measured, float expected);
+void record_test_result(const char* test_name, bool passed, float measured);
 void print_test_summary(void);
 void reset_test_counters(void);
 
-// Test suite runner
+// Test suite runner (default context)
 int run_validation_suite(void);
 
 #endif // VALIDATION_LIB_H
\ No newline at end of file
@@ -0,0 +1,263 @@
+#include "validation_sink.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void sink_acquire(validation_sink_t* sink) {
+    while (__atomic_test_and_set(&sink->lock, __ATOMIC_ACQUIRE)) {
+    }
+}
+
+static void sink_release(validation_sink_t* sink) {
+    __atomic_clear(&sink->lock, __ATOMIC_RELEASE);
+}
+
+// snprintf reports the length it wanted; anything that did not fit is 0
+static size_t fitted(int length, size_t room) {
+    return (length >= 0 && (size_t)length < room) ? (size_t)length : 0;
+}
+
+static size_t format_text(const char* context, const validation_record_t* record,
+                          char* out, size_t room) {
+    return fitted(snprintf(out, room, "%s%s%s[%s] %s: %.3f (expected: %.3f)\n",
+                           context ? "[" : "", context ? context : "", context ? "] " : "",
+                           record->passed ? "PASS" : "FAIL", record->test_name,
+                           record->measured, record->expected), room);
+}
+
+// Quote a CSV field only when it needs it, doubling embedded quotes
+static size_t csv_field(const char* text, char* out, size_t room) {
+    size_t length = 0;
+    
+    if (!strpbrk(text, ",\"\n\r")) {
+        length = strlen(text);
+        if (length >= room) {
+            return 0;
+        }
+        memcpy(out, text, length);
+        return length;
+    }
+    
+    if (room < 3) {
+        return 0;
+    }
+    out[length++] = '"';
+    for (; *text; text++) {
+        if (length + 3 >= room) {
+            return 0;
+        }
+        if (*text == '"') {
+            out[length++] = '"';
+        }
+        out[length++] = *text;
+    }
+    out[length++] = '"';
+    return length;
+}
+
+static size_t format_csv(const char* context, const validation_record_t* record,
+                         char* out, size_t room) {
+    size_t length = csv_field(context ? context : "", out, room);
+    if (length == 0 && context && *context) {
+        return 0;
+    }
+    
+    int written = snprintf(out + length, room - length, ",%llu,",
+                           (unsigned long long)record->sequence);
+    size_t step = fitted(written, room - length);
+    if (step == 0) {
+        return 0;
+    }
+    length += step;
+    
+    step = csv_field(record->test_name, out + length, room - length);
+    if (step == 0 && record->test_name[0]) {
+        return 0;
+    }
+    length += step;
+    
+    step = fitted(snprintf(out + length, room - length, ",%d,%.9g,%.9g\n", record->passed ? 1 : 0,
+                           record->measured, record->expected), room - length);
+    return step ? length + step : 0;
+}
+
+static size_t json_string(const char* text, char* out, size_t room) {
+    size_t length = 0;
+    
+    if (room < 3) {
+        return 0;
+    }
+    out[length++] = '"';
+    for (; *text; text++) {
+        unsigned char c = (unsigned char)*text;
+        if (length + 8 >= room) {
+            return 0;
+        }
+        if (c == '"' || c == '\\') {
+            out[length++] = '\\';
+            out[length++] = (char)c;
+        } else if (c < 0x20) {
+            length += (size_t)snprintf(out + length, room - length, "\\u%04x", c);
+        } else {
+            out[length++] = (char)c;
+        }
+    }
+    out[length++] = '"';
+    return length;
+}
+
+static size_t format_jsonl(const char* context, const validation_record_t* record,
+                           char* out, size_t room) {
+    size_t length = fitted(snprintf(out, room, "{\"context\":"), room);
+    size_t step;
+    
+    if (length == 0) {
+        return 0;
+    }
+    if (context) {
+        step = json_string(context, out + length, room - length);
+    } else {
+        step = fitted(snprintf(out + length, room - length, "null"), room - length);
+    }
+    if (step == 0) {
+        return 0;
+    }
+    length += step;
+    
+    step = fitted(snprintf(out + length, room - length, ",\"seq\":%llu,\"test\":",
+                           (unsigned long long)record->sequence), room - length);
+    if (step == 0) {
+        return 0;
+    }
+    length += step;
+    
+    step = json_string(record->test_name, out + length, room - length);
+    if (step == 0) {
+        return 0;
+    }
+    length += step;
+    
+    step = fitted(snprintf(out + length, room - length,
+                           ",\"passed\":%s,\"measured\":%.9g,\"expected\":%.9g}\n",
+                           record->passed ? "true" : "false", record->measured, record->expected),
+                  room - length);
+    return step ? length + step : 0;
+}
+
+static size_t format_binary(const char* context, const validation_record_t* record,
+                            char* out, size_t room) {
+    uint32_t flags = record->passed ? 1u : 0u;
+    (void)context;
+    
+    if (room < VALIDATION_BINARY_RECORD_SIZE) {
+        return 0;
+    }
+    memcpy(out, &record->sequence, 8);
+    memcpy(out + 8, &record->measured, 4);
+    memcpy(out + 12, &record->expected, 4);
+    memcpy(out + 16, &flags, 4);
+    // Names are captured with strncpy, so the tail is already NUL-padded
+    memcpy(out + 20, record->test_name, VALIDATION_RECORD_NAME_LEN);
+    out[20 + VALIDATION_RECORD_NAME_LEN - 1] = '\0';
+    return VALIDATION_BINARY_RECORD_SIZE;
+}
+
+int validation_sink_open_custom(validation_sink_t* sink, validation_sink_format_fn format,
+                                FILE* stream, size_t buffer_size) {
+    if (buffer_size == 0) {
+        buffer_size = VALIDATION_SINK_BUFFER_SIZE;
+    }
+    
+    memset(sink, 0, sizeof(*sink));
+    sink->buffer = malloc(buffer_size);
+    if (!sink->buffer || !format || !stream) {
+        free(sink->buffer);
+        sink->buffer = NULL;
+        return -1;
+    }
+    sink->format = format;
+    sink->stream = stream;
+    sink->capacity = buffer_size;
+    return 0;
+}
+
+int validation_sink_open(validation_sink_t* sink, validation_sink_format_t format,
+                         FILE* stream, size_t buffer_size) {
+    static const validation_sink_format_fn formatters[] = {
+        format_text, format_csv, format_jsonl, format_binary
+    };
+    static const char csv_header[] = "context,sequence,test,passed,measured,expected\n";
+    
+    // Preambles go through the buffer like everything else, so it must hold them
+    size_t preamble = format == VALIDATION_SINK_CSV ? sizeof(csv_header) - 1 :
+                      format == VALIDATION_SINK_BINARY ? VALIDATION_BINARY_HEADER_SIZE : 0;
+    if ((unsigned)format >= sizeof(formatters) / sizeof(formatters[0]) ||
+        (buffer_size != 0 && buffer_size < preamble) ||
+        validation_sink_open_custom(sink, formatters[format], stream, buffer_size) != 0) {
+        return -1;
+    }
+    
+    if (format == VALIDATION_SINK_CSV) {
+        memcpy(sink->buffer, csv_header, preamble);
+        sink->used = preamble;
+    } else if (format == VALIDATION_SINK_BINARY) {
+        uint32_t header[3] = {
+            VALIDATION_BINARY_MAGIC, VALIDATION_BINARY_VERSION, VALIDATION_BINARY_RECORD_SIZE
+        };
+        memcpy(sink->buffer, header, VALIDATION_BINARY_HEADER_SIZE);
+        sink->used = VALIDATION_BINARY_HEADER_SIZE;
+    }
+    return 0;
+}
+
+// Caller holds the sink lock
+static int sink_drain(validation_sink_t* sink) {
+    if (sink->used > 0) {
+        if (fwrite(sink->buffer, 1, sink->used, sink->stream) != sink->used) {
+            sink->write_errors++;
+        }
+        sink->used = 0;
+    }
+    return sink->write_errors ? -1 : 0;
+}
+
+void validation_sink_write(validation_sink_t* sink, const char* context,
+                           const validation_record_t* records, size_t count) {
+    sink_acquire(sink);
+    for (size_t i = 0; i < count; i++) {
+        size_t length = sink->format(context, &records[i], sink->buffer + sink->used,
+                                     sink->capacity - sink->used);
+        if (length == 0 && sink->used > 0) {
+            sink_drain(sink);
+            length = sink->format(context, &records[i], sink->buffer, sink->capacity);
+        }
+        
+        if (length == 0) {
+            sink->dropped++;
+        } else {
+            sink->used += length;
+            sink->records++;
+        }
+    }
+    sink_release(sink);
+}
+
+int validation_sink_flush(validation_sink_t* sink) {
+    sink_acquire(sink);
+    int status = sink_drain(sink);
+    if (fflush(sink->stream) != 0) {
+        status = -1;
+    }
+    sink_release(sink);
+    return status;
+}
+
+int validation_sink_close(validation_sink_t* sink) {
+    if (!sink->buffer) {
+        return 0;
+    }
+    int status = validation_sink_flush(sink);
+    free(sink->buffer);
+    sink->buffer = NULL;
+    sink->capacity = 0;
+    return status;
+}
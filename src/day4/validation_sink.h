@@ -0,0 +1,68 @@
+#ifndef VALIDATION_SINK_H
+#define VALIDATION_SINK_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Result sinks: machine-readable (or human) output for logged results. The
+// logging hot path only captures a fixed-size record; sinks format records
+// in batches into a large private buffer and write it out with one fwrite
+// when it fills or on flush. A validation context can feed several sinks.
+
+#define VALIDATION_RECORD_NAME_LEN  32
+#define VALIDATION_SINK_BUFFER_SIZE (64 * 1024)
+
+typedef struct {
+    uint64_t sequence;          // Position in the context's result stream
+    float measured;
+    float expected;
+    bool passed;
+    char test_name[VALIDATION_RECORD_NAME_LEN];
+} validation_record_t;
+
+typedef struct validation_sink validation_sink_t;
+
+// Formats one record into out[0..room). Returns the bytes written, or 0 if
+// it did not fit (the sink then flushes and retries once).
+typedef size_t (*validation_sink_format_fn)(const char* context, const validation_record_t* record,
+                                            char* out, size_t room);
+
+typedef enum {
+    VALIDATION_SINK_TEXT = 0,   // Same lines as the console log
+    VALIDATION_SINK_CSV,        // Header row, then one row per result
+    VALIDATION_SINK_JSONL,      // One JSON object per line
+    VALIDATION_SINK_BINARY      // File header, then fixed 52-byte records
+} validation_sink_format_t;
+
+struct validation_sink {
+    validation_sink_format_fn format;
+    FILE* stream;               // Not owned: closing the sink leaves it open
+    char* buffer;
+    size_t used;
+    size_t capacity;
+    uint64_t records;
+    uint64_t dropped;           // Records larger than the whole buffer
+    int write_errors;
+    uint8_t lock;
+};
+
+int validation_sink_open(validation_sink_t* sink, validation_sink_format_t format,
+                         FILE* stream, size_t buffer_size);
+int validation_sink_open_custom(validation_sink_t* sink, validation_sink_format_fn format,
+                                FILE* stream, size_t buffer_size);
+void validation_sink_write(validation_sink_t* sink, const char* context,
+                           const validation_record_t* records, size_t count);
+int validation_sink_flush(validation_sink_t* sink);
+int validation_sink_close(validation_sink_t* sink);
+
+// Binary format: little-endian, header then records of
+//   u64 sequence, f32 measured, f32 expected, u32 flags (bit 0: passed),
+//   char test_name[32] (NUL-padded)
+#define VALIDATION_BINARY_MAGIC       0x53455256u  // "VRES"
+#define VALIDATION_BINARY_VERSION     1
+#define VALIDATION_BINARY_HEADER_SIZE 12           // magic, version, record size
+#define VALIDATION_BINARY_RECORD_SIZE 52
+
+#endif // VALIDATION_SINK_H
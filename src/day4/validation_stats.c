@@ -0,0 +1,244 @@
+#include "validation_stats.h"
+#include <math.h>
+
+static const double quantile_probability[VALIDATION_STATS_QUANTILES] = { 0.50, 0.95, 0.99 };
+
+// Desired marker positions advance by these fractions of each new sample
+static void p2_increments(double p, double increments[5]) {
+    increments[0] = 0.0;
+    increments[1] = p / 2.0;
+    increments[2] = p;
+    increments[3] = (1.0 + p) / 2.0;
+    increments[4] = 1.0;
+}
+
+static void p2_init(validation_p2_t* p2, double p) {
+    p2->p = p;
+    for (int i = 0; i < 5; i++) {
+        p2->heights[i] = 0.0;
+        p2->desired[i] = 0.0;
+        p2->positions[i] = i;
+    }
+}
+
+static void sort_small(double* values, int count) {
+    for (int i = 1; i < count; i++) {
+        double value = values[i];
+        int j = i - 1;
+        while (j >= 0 && values[j] > value) {
+            values[j + 1] = values[j];
+            j--;
+        }
+        values[j + 1] = value;
+    }
+}
+
+// Piecewise-parabolic prediction of marker i moved by d (+1 or -1)
+static double p2_parabolic(const validation_p2_t* p2, int i, int d) {
+    const double* q = p2->heights;
+    const int64_t* n = p2->positions;
+    
+    return q[i] + (double)d / (double)(n[i + 1] - n[i - 1]) *
+           ((double)(n[i] - n[i - 1] + d) * (q[i + 1] - q[i]) / (double)(n[i + 1] - n[i]) +
+            (double)(n[i + 1] - n[i] - d) * (q[i] - q[i - 1]) / (double)(n[i] - n[i - 1]));
+}
+
+static double p2_linear(const validation_p2_t* p2, int i, int d) {
+    const double* q = p2->heights;
+    const int64_t* n = p2->positions;
+    
+    return q[i] + (double)d * (q[i + d] - q[i]) / (double)(n[i + d] - n[i]);
+}
+
+// count is the number of samples seen before this one
+static void p2_add(validation_p2_t* p2, uint64_t count, double value) {
+    if (count < 5) {
+        p2->heights[count] = value;
+        if (count == 4) {
+            double increments[5];
+            
+            sort_small(p2->heights, 5);
+            p2_increments(p2->p, increments);
+            for (int i = 0; i < 5; i++) {
+                p2->positions[i] = i;
+                p2->desired[i] = 4.0 * increments[i];
+            }
+        }
+        return;
+    }
+    
+    double* q = p2->heights;
+    int64_t* n = p2->positions;
+    int cell;
+    
+    if (value < q[0]) {
+        q[0] = value;
+        cell = 0;
+    } else if (value < q[1]) {
+        cell = 0;
+    } else if (value < q[2]) {
+        cell = 1;
+    } else if (value < q[3]) {
+        cell = 2;
+    } else if (value <= q[4]) {
+        cell = 3;
+    } else {
+        q[4] = value;
+        cell = 3;
+    }
+    
+    double increments[5];
+    p2_increments(p2->p, increments);
+    for (int i = cell + 1; i < 5; i++) {
+        n[i]++;
+    }
+    for (int i = 0; i < 5; i++) {
+        p2->desired[i] += increments[i];
+    }
+    
+    // Nudge the three middle markers toward their desired positions
+    for (int i = 1; i <= 3; i++) {
+        double offset = p2->desired[i] - (double)n[i];
+        if ((offset >= 1.0 && n[i + 1] - n[i] > 1) || (offset <= -1.0 && n[i - 1] - n[i] < -1)) {
+            int d = (offset > 0.0) ? 1 : -1;
+            double height = p2_parabolic(p2, i, d);
+            if (q[i - 1] < height && height < q[i + 1]) {
+                q[i] = height;
+            } else {
+                q[i] = p2_linear(p2, i, d);
+            }
+            n[i] += d;
+        }
+    }
+}
+
+static double p2_estimate(const validation_p2_t* p2, uint64_t count) {
+    if (count == 0) {
+        return 0.0;
+    }
+    if (count >= 5) {
+        return p2->heights[2];
+    }
+    
+    // Too few samples for markers: nearest rank over the raw values
+    double values[5];
+    for (uint64_t i = 0; i < count; i++) {
+        values[i] = p2->heights[i];
+    }
+    sort_small(values, (int)count);
+    return values[(int)(p2->p * (double)(count - 1) + 0.5)];
+}
+
+void validation_stats_init(validation_stats_t* stats) {
+    stats->count = 0;
+    stats->mean = 0.0;
+    stats->m2 = 0.0;
+    stats->min = 0.0;
+    stats->max = 0.0;
+    for (int i = 0; i < VALIDATION_STATS_QUANTILES; i++) {
+        p2_init(&stats->quantiles[i], quantile_probability[i]);
+    }
+}
+
+void validation_stats_add(validation_stats_t* stats, double value) {
+    for (int i = 0; i < VALIDATION_STATS_QUANTILES; i++) {
+        p2_add(&stats->quantiles[i], stats->count, value);
+    }
+    
+    if (stats->count == 0 || value < stats->min) {
+        stats->min = value;
+    }
+    if (stats->count == 0 || value > stats->max) {
+        stats->max = value;
+    }
+    
+    stats->count++;
+    double delta = value - stats->mean;
+    stats->mean += delta / (double)stats->count;
+    stats->m2 += delta * (value - stats->mean);
+}
+
+// Combine marker states of two estimators that both have at least five
+// samples: heights are count-weighted, ranks add, the extremes are exact
+static void p2_merge(validation_p2_t* dst, uint64_t dst_count,
+                     const validation_p2_t* src, uint64_t src_count) {
+    double total = (double)(dst_count + src_count);
+    double increments[5];
+    
+    p2_increments(dst->p, increments);
+    for (int i = 1; i <= 3; i++) {
+        dst->heights[i] = (dst->heights[i] * (double)dst_count +
+                           src->heights[i] * (double)src_count) / total;
+        dst->positions[i] += src->positions[i];
+    }
+    if (src->heights[0] < dst->heights[0]) {
+        dst->heights[0] = src->heights[0];
+    }
+    if (src->heights[4] > dst->heights[4]) {
+        dst->heights[4] = src->heights[4];
+    }
+    dst->positions[0] = 0;
+    dst->positions[4] = (int64_t)(dst_count + src_count) - 1;
+    for (int i = 0; i < 5; i++) {
+        dst->desired[i] = (total - 1.0) * increments[i];
+    }
+}
+
+void validation_stats_merge(validation_stats_t* dst, const validation_stats_t* src) {
+    if (src->count == 0) {
+        return;
+    }
+    
+    // A side with fewer than five samples still has them raw: replay exactly
+    if (src->count < 5) {
+        for (uint64_t i = 0; i < src->count; i++) {
+            validation_stats_add(dst, src->quantiles[0].heights[i]);
+        }
+        return;
+    }
+    if (dst->count < 5) {
+        validation_stats_t small = *dst;
+        *dst = *src;
+        for (uint64_t i = 0; i < small.count; i++) {
+            validation_stats_add(dst, small.quantiles[0].heights[i]);
+        }
+        return;
+    }
+    
+    for (int i = 0; i < VALIDATION_STATS_QUANTILES; i++) {
+        p2_merge(&dst->quantiles[i], dst->count, &src->quantiles[i], src->count);
+    }
+    
+    // Chan et al. pairwise update
+    double total = (double)(dst->count + src->count);
+    double delta = src->mean - dst->mean;
+    dst->m2 += src->m2 + delta * delta * (double)dst->count * (double)src->count / total;
+    dst->mean += delta * (double)src->count / total;
+    dst->count += src->count;
+    
+    if (src->min < dst->min) {
+        dst->min = src->min;
+    }
+    if (src->max > dst->max) {
+        dst->max = src->max;
+    }
+}
+
+double validation_stats_mean(const validation_stats_t* stats) {
+    return stats->mean;
+}
+
+double validation_stats_variance(const validation_stats_t* stats) {
+    return (stats->count > 1) ? stats->m2 / (double)(stats->count - 1) : 0.0;
+}
+
+double validation_stats_stddev(const validation_stats_t* stats) {
+    return sqrt(validation_stats_variance(stats));
+}
+
+double validation_stats_quantile(const validation_stats_t* stats, validation_quantile_t which) {
+    if (which >= VALIDATION_STATS_QUANTILES) {
+        return 0.0;
+    }
+    return p2_estimate(&stats->quantiles[which], stats->count);
+}
@@ -0,0 +1,47 @@
+#ifndef VALIDATION_STATS_H
+#define VALIDATION_STATS_H
+
+#include <stdint.h>
+
+// Streaming statistics for one measured parameter in constant memory:
+//   - Welford running mean/variance (exact, numerically stable)
+//   - min/max
+//   - P² estimators (Jain & Chlamtac) for p50, p95 and p99
+// Accumulators from parallel workers combine with validation_stats_merge().
+// Mean, variance, min and max merge exactly; merged quantiles are estimates.
+
+typedef enum {
+    VALIDATION_STATS_P50 = 0,
+    VALIDATION_STATS_P95,
+    VALIDATION_STATS_P99,
+    VALIDATION_STATS_QUANTILES
+} validation_quantile_t;
+
+// P² marker state for one quantile. Until five samples have been seen,
+// heights[] holds the raw samples.
+typedef struct {
+    double p;
+    double heights[5];
+    double desired[5];
+    int64_t positions[5];
+} validation_p2_t;
+
+typedef struct {
+    uint64_t count;
+    double mean;
+    double m2;                  // Sum of squared deviations from the mean
+    double min;
+    double max;
+    validation_p2_t quantiles[VALIDATION_STATS_QUANTILES];
+} validation_stats_t;
+
+void validation_stats_init(validation_stats_t* stats);
+void validation_stats_add(validation_stats_t* stats, double value);
+void validation_stats_merge(validation_stats_t* dst, const validation_stats_t* src);
+
+double validation_stats_mean(const validation_stats_t* stats);
+double validation_stats_variance(const validation_stats_t* stats);    // Sample variance
+double validation_stats_stddev(const validation_stats_t* stats);
+double validation_stats_quantile(const validation_stats_t* stats, validation_quantile_t which);
+
+#endif // VALIDATION_STATS_H
@@ -1,13 +1,29 @@
+#define _POSIX_C_SOURCE 200112L
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdarg.h>
 #include <string.h>
 #include <time.h>
 
+#if !defined(__riscv)
+#define FRAMEWORK_HAVE_THREADS 1
+#define FRAMEWORK_HAVE_FSYNC 1
+#define FRAMEWORK_HAVE_TRUNCATE 1
+#include <pthread.h>
+#include <unistd.h>
+#else
+#define FRAMEWORK_HAVE_THREADS 0
+#define FRAMEWORK_HAVE_FSYNC 0
+#define FRAMEWORK_HAVE_TRUNCATE 0
+#endif
+
 // Include all previous modules
 #include "../day4/validation_lib.h"
 #include "../day4/fpga_hal.h"
+#include "../day4/hal_backend.h"
+#include "../day4/perf_clock.h"
 
 // Validation framework core structures
 typedef enum {
@@ -26,119 +42,450 @@ typedef enum {
     TEST_PRIORITY_CRITICAL
 } test_priority_t;
 
+// Peripherals a test touches. Tests that share one never run at the same
+// time; tests with disjoint sets may run concurrently.
+typedef enum {
+    TEST_RESOURCE_GPIO  = 1u << 0,
+    TEST_RESOURCE_TIMER = 1u << 1,
+    TEST_RESOURCE_ADC   = 1u << 2,
+    TEST_RESOURCE_UART  = 1u << 3,
+    TEST_RESOURCE_ALL   = 0xFu
+} test_resource_t;
+
+#define TEST_RESOURCE_COUNT 4
+
+// Execution time over every run of a test (--repeat), in nanoseconds
 typedef struct {
-    char name[64];
-    char description[256];
-    test_status_t status;
-    test_priority_t priority;
-    uint32_t execution_time_ms;
-    uint32_t start_time;
-    uint32_t end_time;
-    char error_message[128];
-    float measured_value;
-    float expected_value;
-    float tolerance;
-} test_case_t;
+    uint32_t runs;
+    uint64_t total_ns;
+    uint64_t min_ns;
+    uint64_t median_ns;
+    uint64_t p95_ns;
+    uint64_t p99_ns;
+    uint64_t max_ns;
+} test_timing_t;
+
+typedef struct test_case test_case_t;
+typedef void (*test_fn_t)(test_case_t* test);
+
+// Suites and tests are named by dense ids in registration order
+typedef uint32_t suite_id_t;
+typedef uint32_t test_id_t;
+
+#define FRAMEWORK_NO_ID UINT32_MAX
+
+// The cold part of a test: what it is and how to run it. Its results live
+// in the framework's result columns (test_results_t) under the same id.
+struct test_case {
+    test_id_t id;
+    const char* name;               // Interned
+    const char* description;        // Interned
+    const char* error_message;      // Interned, NULL until a run fails
+    test_fn_t run;                  // Calls test_start() and test_end()
+    uint32_t resources;             // test_resource_t mask
+    uint32_t parameter;             // Per-test argument (e.g. ADC channel)
+    test_id_t next;                 // Next test in the same suite
+    perf_ticks_t start_ticks;       // Current run
+    uint64_t execution_time_ns;     // Last run
+};
 
 typedef struct {
-    char suite_name[64];
-    test_case_t* tests;
+    const char* suite_name;         // Interned
+    test_id_t first_test;
+    test_id_t last_test;
     uint32_t test_count;
     uint32_t tests_passed;
     uint32_t tests_failed;
     uint32_t tests_skipped;
-    uint32_t total_execution_time_ms;
+    uint64_t total_execution_time_ns;
     bool suite_enabled;
 } test_suite_t;
 
+// Framework objects are bump-allocated from an arena of large blocks and
+// released together by framework_cleanup(). A pool hands out fixed-size
+// objects in chunks of POOL_CHUNK_OBJECTS from the arena; chunks never move,
+// so a pointer to a suite or test stays valid after later registrations.
+#define ARENA_BLOCK_SIZE   (1u << 20)
+#define ARENA_ALIGN        16
+#define POOL_CHUNK_SHIFT   8
+#define POOL_CHUNK_OBJECTS (1u << POOL_CHUNK_SHIFT)
+#define POOL_MAX_CHUNKS    1024         // 262144 objects per pool
+
+typedef struct arena_block {
+    struct arena_block* next;
+    size_t used;
+    size_t size;
+    unsigned char data[];
+} arena_block_t;
+
 typedef struct {
-    test_suite_t* suites;
-    uint32_t suite_count;
+    arena_block_t* head;        // Block being filled
+    uint32_t block_count;
+} arena_t;
+
+typedef struct {
+    size_t object_size;
+    uint32_t count;
+    void* chunks[POOL_MAX_CHUNKS];
+} object_pool_t;
+
+// Names, descriptions and error messages, each stored once in the arena.
+// Open addressing over a power-of-two slot array kept under half full.
+typedef struct {
+    const char** slots;
+    uint32_t capacity;
+    uint32_t count;
+} string_table_t;
+
+// The hot part of POOL_CHUNK_OBJECTS tests, one packed array per field, so
+// a pass over one field of every test reads only that field
+typedef struct {
+    uint8_t status[POOL_CHUNK_OBJECTS];         // test_status_t
+    uint8_t priority[POOL_CHUNK_OBJECTS];       // test_priority_t
+    suite_id_t suite[POOL_CHUNK_OBJECTS];
+    float measured[POOL_CHUNK_OBJECTS];
+    float expected[POOL_CHUNK_OBJECTS];
+    float tolerance[POOL_CHUNK_OBJECTS];
+    uint32_t runs[POOL_CHUNK_OBJECTS];
+    uint64_t total_ns[POOL_CHUNK_OBJECTS];
+    uint64_t min_ns[POOL_CHUNK_OBJECTS];
+    uint64_t median_ns[POOL_CHUNK_OBJECTS];
+    uint64_t p95_ns[POOL_CHUNK_OBJECTS];
+    uint64_t p99_ns[POOL_CHUNK_OBJECTS];
+    uint64_t max_ns[POOL_CHUNK_OBJECTS];
+} test_results_t;
+
+// Reports streamed while the tests run (see reports_open())
+typedef enum {
+    REPORT_HTML,
+    REPORT_JUNIT,
+    REPORT_JSONL,
+    REPORT_FORMAT_COUNT
+} report_format_id_t;
+
+typedef struct report_stream report_stream_t;
+
+typedef struct {
+    arena_t arena;
+    object_pool_t suites;       // test_suite_t by suite_id_t
+    object_pool_t tests;        // test_case_t by test_id_t
+    test_results_t* results[POOL_MAX_CHUNKS];   // Chunk n holds tests n*256...
+    string_table_t strings;
     uint32_t total_tests;
     uint32_t total_passed;
     uint32_t total_failed;
     uint32_t total_skipped;
-    uint32_t framework_start_time;
-    uint32_t framework_end_time;
-    char report_filename[128];
+    time_t framework_start_time;
+    time_t framework_end_time;
+    perf_ticks_t run_start_ticks;
+    perf_ticks_t run_end_ticks;
+    char report_paths[REPORT_FORMAT_COUNT][128];    // Empty = not written
+    report_stream_t* reports[REPORT_FORMAT_COUNT];  // Open while the tests run
     bool verbose_output;
     bool stop_on_failure;
+    uint32_t jobs;              // Worker threads, 0 = one per CPU
+    uint32_t repeat;            // Runs per test
 } validation_framework_t;
 
 // Global framework instance
 static validation_framework_t g_framework = {0};
 
-// Framework initialization and cleanup
-void framework_init(const char* report_filename, bool verbose, bool stop_on_fail) {
-    memset(&g_framework, 0, sizeof(validation_framework_t));
+// One result field of a test, as an lvalue
+#define TEST_RESULT(column, id) \
+    (g_framework.results[(id) >> POOL_CHUNK_SHIFT]->column[(id) & (POOL_CHUNK_OBJECTS - 1)])
+
+// Zeroed memory that lives until arena_release(), or NULL when out of memory.
+// align is a power of two no larger than ARENA_ALIGN.
+static void* arena_alloc(arena_t* arena, size_t size, size_t align) {
+    arena_block_t* block = arena->head;
+    if (block) {
+        size_t pad = (size_t)(-(uintptr_t)(block->data + block->used) & (align - 1));
+        if (block->used + pad + size <= block->size) {
+            void* ptr = block->data + block->used + pad;
+            block->used += pad + size;
+            return ptr;
+        }
+    }
     
-    if (report_filename) {
-        strncpy(g_framework.report_filename, report_filename, 127);
-        g_framework.report_filename[127] = '\0';
+    // Fresh blocks come from calloc, so nothing handed out needs clearing
+    size_t capacity = (size + ARENA_ALIGN > ARENA_BLOCK_SIZE) ? size + ARENA_ALIGN
+                                                              : ARENA_BLOCK_SIZE;
+    block = calloc(1, sizeof(arena_block_t) + capacity);
+    if (!block) return NULL;
+    
+    block->size = capacity;
+    block->next = arena->head;
+    arena->head = block;
+    arena->block_count++;
+    return arena_alloc(arena, size, align);
+}
+
+static void arena_release(arena_t* arena) {
+    while (arena->head) {
+        arena_block_t* next = arena->head->next;
+        free(arena->head);
+        arena->head = next;
+    }
+    arena->block_count = 0;
+}
+
+// Returns the new object's id, or FRAMEWORK_NO_ID when the pool is full
+static uint32_t pool_add(object_pool_t* pool, arena_t* arena) {
+    uint32_t chunk = pool->count >> POOL_CHUNK_SHIFT;
+    if (chunk >= POOL_MAX_CHUNKS) return FRAMEWORK_NO_ID;
+    
+    if (!pool->chunks[chunk]) {
+        pool->chunks[chunk] = arena_alloc(arena, POOL_CHUNK_OBJECTS * pool->object_size,
+                                          ARENA_ALIGN);
+        if (!pool->chunks[chunk]) return FRAMEWORK_NO_ID;
+    }
+    return pool->count++;
+}
+
+static void* pool_get(const object_pool_t* pool, uint32_t id) {
+    if (id >= pool->count) return NULL;
+    return (unsigned char*)pool->chunks[id >> POOL_CHUNK_SHIFT] +
+           (size_t)(id & (POOL_CHUNK_OBJECTS - 1)) * pool->object_size;
+}
+
+// FNV-1a
+static uint32_t string_hash(const char* text) {
+    uint32_t hash = 2166136261u;
+    for (; *text; text++) {
+        hash = (hash ^ (uint8_t)*text) * 16777619u;
+    }
+    return hash;
+}
+
+static bool string_table_grow(string_table_t* table) {
+    uint32_t capacity = table->capacity ? table->capacity * 2 : 256;
+    const char** slots = calloc(capacity, sizeof(const char*));
+    if (!slots) return false;
+    
+    for (uint32_t i = 0; i < table->capacity; i++) {
+        const char* text = table->slots[i];
+        if (!text) continue;
+        uint32_t slot = string_hash(text) & (capacity - 1);
+        while (slots[slot]) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        slots[slot] = text;
+    }
+    free(table->slots);
+    table->slots = slots;
+    table->capacity = capacity;
+    return true;
+}
+
+// Returns the table's copy of text, or NULL when out of memory
+static const char* string_intern(string_table_t* table, arena_t* arena, const char* text) {
+    if ((table->count + 1) * 2 > table->capacity && !string_table_grow(table)) return NULL;
+    
+    uint32_t mask = table->capacity - 1;
+    uint32_t slot = string_hash(text) & mask;
+    while (table->slots[slot]) {
+        if (strcmp(table->slots[slot], text) == 0) return table->slots[slot];
+        slot = (slot + 1) & mask;
+    }
+    
+    size_t length = strlen(text) + 1;
+    char* copy = arena_alloc(arena, length, 1);
+    if (!copy) return NULL;
+    memcpy(copy, text, length);
+    table->slots[slot] = copy;
+    table->count++;
+    return copy;
+}
+
+#if FRAMEWORK_HAVE_THREADS
+// Failing tests intern their message while other workers run
+static pthread_mutex_t intern_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static const char* framework_intern(const char* text) {
+#if FRAMEWORK_HAVE_THREADS
+    pthread_mutex_lock(&intern_lock);
+#endif
+    const char* copy = string_intern(&g_framework.strings, &g_framework.arena, text);
+#if FRAMEWORK_HAVE_THREADS
+    pthread_mutex_unlock(&intern_lock);
+#endif
+    return copy;
+}
+
+// NULL for FRAMEWORK_NO_ID or an id that was never handed out
+test_suite_t* framework_suite(suite_id_t id) {
+    return pool_get(&g_framework.suites, id);
+}
+
+test_case_t* framework_test(test_id_t id) {
+    return pool_get(&g_framework.tests, id);
+}
+
+static test_timing_t test_timing_get(test_id_t id) {
+    test_timing_t timing;
+    timing.runs = TEST_RESULT(runs, id);
+    timing.total_ns = TEST_RESULT(total_ns, id);
+    timing.min_ns = TEST_RESULT(min_ns, id);
+    timing.median_ns = TEST_RESULT(median_ns, id);
+    timing.p95_ns = TEST_RESULT(p95_ns, id);
+    timing.p99_ns = TEST_RESULT(p99_ns, id);
+    timing.max_ns = TEST_RESULT(max_ns, id);
+    return timing;
+}
+
+static void test_timing_put(test_id_t id, const test_timing_t* timing) {
+    TEST_RESULT(runs, id) = timing->runs;
+    TEST_RESULT(total_ns, id) = timing->total_ns;
+    TEST_RESULT(min_ns, id) = timing->min_ns;
+    TEST_RESULT(median_ns, id) = timing->median_ns;
+    TEST_RESULT(p95_ns, id) = timing->p95_ns;
+    TEST_RESULT(p99_ns, id) = timing->p99_ns;
+    TEST_RESULT(max_ns, id) = timing->max_ns;
+}
+
+// Durations are printed in the largest unit that keeps them above 1
+static const char* format_ns(uint64_t ns, char* buffer, size_t size) {
+    if (ns < 1000) {
+        snprintf(buffer, size, "%llu ns", (unsigned long long)ns);
+    } else if (ns < 1000000) {
+        snprintf(buffer, size, "%.3f us", ns / 1e3);
+    } else if (ns < 1000000000) {
+        snprintf(buffer, size, "%.3f ms", ns / 1e6);
     } else {
-        strcpy(g_framework.report_filename, "validation_report.html");
+        snprintf(buffer, size, "%.3f s", ns / 1e9);
     }
+    return buffer;
+}
+
+static uint64_t ticks_to_ns(perf_ticks_t start, perf_ticks_t end) {
+    perf_ticks_t elapsed = end - start;
+    perf_ticks_t overhead = perf_clock_overhead();
+    return perf_clock_to_ns(elapsed > overhead ? elapsed - overhead : 0);
+}
+
+static void reports_close(bool final);
+
+// Sets where a report is written; NULL or "" turns it off
+void framework_set_report(report_format_id_t format, const char* filename) {
+    char* path = g_framework.report_paths[format];
+    strncpy(path, filename ? filename : "", 127);
+    path[127] = '\0';
+}
+
+// Framework initialization and cleanup
+void framework_init(const char* report_filename, bool verbose, bool stop_on_fail,
+                    uint32_t jobs, uint32_t repeat) {
+    memset(&g_framework, 0, sizeof(validation_framework_t));
+    g_framework.suites.object_size = sizeof(test_suite_t);
+    g_framework.tests.object_size = sizeof(test_case_t);
+    
+    framework_set_report(REPORT_HTML, report_filename ? report_filename : "validation_report.html");
     
     g_framework.verbose_output = verbose;
     g_framework.stop_on_failure = stop_on_fail;
-    g_framework.framework_start_time = (uint32_t)time(NULL);
+    g_framework.jobs = jobs;
+    g_framework.repeat = repeat > 0 ? repeat : 1;
+    g_framework.framework_start_time = time(NULL);
+    perf_clock_calibrate();
     
     printf("=== FPGA Validation Framework v1.0 ===\n");
-    printf("Report file: %s\n", g_framework.report_filename);
+    printf("Report file: %s\n", g_framework.report_paths[REPORT_HTML]);
     printf("Verbose mode: %s\n", verbose ? "Enabled" : "Disabled");
     printf("Stop on failure: %s\n", stop_on_fail ? "Enabled" : "Disabled");
+    if (jobs > 0) {
+        printf("Worker threads: %u\n", jobs);
+    } else {
+        printf("Worker threads: one per CPU\n");
+    }
+    printf("Runs per test: %u\n", g_framework.repeat);
+    printf("Test clock: %s\n", perf_clock_source());
     printf("========================================\n\n");
 }
 
 void framework_cleanup(void) {
-    g_framework.framework_end_time = (uint32_t)time(NULL);
-    
-    // Free allocated memory
-    for (uint32_t i = 0; i < g_framework.suite_count; i++) {
-        if (g_framework.suites[i].tests) {
-            free(g_framework.suites[i].tests);
-        }
-    }
-    
-    if (g_framework.suites) {
-        free(g_framework.suites);
-    }
+    // Reports not finished by framework_generate_report() stay marked incomplete
+    reports_close(false);
+    
+    // Every suite, test, result chunk and string goes with the arena
+    arena_release(&g_framework.arena);
+    g_framework.suites.count = 0;
+    g_framework.tests.count = 0;
+    memset(g_framework.suites.chunks, 0, sizeof(g_framework.suites.chunks));
+    memset(g_framework.tests.chunks, 0, sizeof(g_framework.tests.chunks));
+    memset(g_framework.results, 0, sizeof(g_framework.results));
+    free(g_framework.strings.slots);
+    memset(&g_framework.strings, 0, sizeof(g_framework.strings));
     
     printf("\nFramework cleanup completed.\n");
 }
 
 // Test suite management
-test_suite_t* framework_add_suite(const char* suite_name, uint32_t test_capacity) {
-    g_framework.suite_count++;
-    g_framework.suites = realloc(g_framework.suites, 
-                                g_framework.suite_count * sizeof(test_suite_t));
-    
-    test_suite_t* suite = &g_framework.suites[g_framework.suite_count - 1];
-    memset(suite, 0, sizeof(test_suite_t));
+// Returns FRAMEWORK_NO_ID when the suite cannot be stored
+suite_id_t framework_add_suite(const char* suite_name) {
+    const char* name = framework_intern(suite_name);
+    suite_id_t id = name ? pool_add(&g_framework.suites, &g_framework.arena) : FRAMEWORK_NO_ID;
+    test_suite_t* suite = framework_suite(id);
+    if (!suite) {
+        printf("Error: Could not add test suite %s\n", suite_name);
+        return FRAMEWORK_NO_ID;
+    }
     
-    strncpy(suite->suite_name, suite_name, 63);
-    suite->suite_name[63] = '\0';
-    suite->tests = calloc(test_capacity, sizeof(test_case_t));
+    suite->suite_name = name;
+    suite->first_test = FRAMEWORK_NO_ID;
+    suite->last_test = FRAMEWORK_NO_ID;
     suite->test_count = 0;
     suite->suite_enabled = true;
     
-    printf("Added test suite: %s (capacity: %d tests)\n", suite_name, test_capacity);
-    return suite;
+    printf("Added test suite: %s\n", suite_name);
+    return id;
 }
 
-test_case_t* suite_add_test(test_suite_t* suite, const char* test_name, 
-                           const char* description, test_priority_t priority) {
-    if (!suite || !suite->tests) return NULL;
+// Returns FRAMEWORK_NO_ID for an unknown suite or when the test cannot be stored
+test_id_t suite_add_test(suite_id_t suite_id, const char* test_name, 
+                         const char* description, test_priority_t priority,
+                         test_fn_t run, uint32_t resources) {
+    test_suite_t* suite = framework_suite(suite_id);
+    if (!suite) return FRAMEWORK_NO_ID;
+    
+    // Result columns grow a chunk at a time alongside the test pool
+    uint32_t chunk = g_framework.tests.count >> POOL_CHUNK_SHIFT;
+    if (chunk < POOL_MAX_CHUNKS && !g_framework.results[chunk]) {
+        g_framework.results[chunk] = arena_alloc(&g_framework.arena, sizeof(test_results_t),
+                                                 ARENA_ALIGN);
+    }
+    
+    const char* name = framework_intern(test_name);
+    const char* desc = framework_intern(description);
+    test_id_t id = FRAMEWORK_NO_ID;
+    if (chunk < POOL_MAX_CHUNKS && g_framework.results[chunk] && name && desc) {
+        id = pool_add(&g_framework.tests, &g_framework.arena);
+    }
+    
+    test_case_t* test = framework_test(id);
+    if (!test) {
+        printf("Error: Could not add test %s to %s\n", test_name, suite->suite_name);
+        return FRAMEWORK_NO_ID;
+    }
     
-    test_case_t* test = &suite->tests[suite->test_count++];
-    memset(test, 0, sizeof(test_case_t));
+    // Tests of a suite are chained in registration order
+    test->id = id;
+    test->next = FRAMEWORK_NO_ID;
+    if (suite->last_test == FRAMEWORK_NO_ID) {
+        suite->first_test = id;
+    } else {
+        framework_test(suite->last_test)->next = id;
+    }
+    suite->last_test = id;
+    suite->test_count++;
     
-    strncpy(test->name, test_name, 63);
-    test->name[63] = '\0';
-    strncpy(test->description, description, 255);
-    test->description[255] = '\0';
-    test->status = TEST_STATUS_PENDING;
-    test->priority = priority;
+    test->name = name;
+    test->description = desc;
+    test->run = run;
+    test->resources = resources;
+    TEST_RESULT(status, id) = TEST_STATUS_PENDING;
+    TEST_RESULT(priority, id) = priority;
+    TEST_RESULT(suite, id) = suite_id;
     
     g_framework.total_tests++;
     
@@ -146,48 +493,53 @@ test_case_t* suite_add_test(test_suite_t* suite, const char* test_name,
         printf("  Added test: %s\n", test_name);
     }
     
-    return test;
+    return id;
 }
 
 // Test execution engine
+static const char* test_status_name(test_status_t status) {
+    switch (status) {
+        case TEST_STATUS_PASSED: return "PASS";
+        case TEST_STATUS_FAILED: return "FAIL";
+        case TEST_STATUS_SKIPPED: return "SKIP";
+        case TEST_STATUS_ERROR: return "ERROR";
+        default: return "UNKNOWN";
+    }
+}
+
 void test_start(test_case_t* test) {
     if (!test) return;
     
-    test->status = TEST_STATUS_RUNNING;
-    test->start_time = (uint32_t)time(NULL);
+    TEST_RESULT(status, test->id) = TEST_STATUS_RUNNING;
     
-    if (g_framework.verbose_output) {
+    if (g_framework.verbose_output && g_framework.repeat == 1) {
         printf("Starting test: %s\n", test->name);
     }
+    
+    test->start_ticks = perf_clock_now();
 }
 
 void test_end(test_case_t* test, test_status_t final_status, 
               const char* error_msg, float measured, float expected, float tolerance) {
     if (!test) return;
     
-    test->end_time = (uint32_t)time(NULL);
-    test->execution_time_ms = (test->end_time - test->start_time) * 1000;
-    test->status = final_status;
-    test->measured_value = measured;
-    test->expected_value = expected;
-    test->tolerance = tolerance;
+    test->execution_time_ns = ticks_to_ns(test->start_ticks, perf_clock_now());
+    TEST_RESULT(status, test->id) = final_status;
+    TEST_RESULT(measured, test->id) = measured;
+    TEST_RESULT(expected, test->id) = expected;
+    TEST_RESULT(tolerance, test->id) = tolerance;
     
-    if (error_msg && final_status != TEST_STATUS_PASSED) {
-        strncpy(test->error_message, error_msg, 127);
-        test->error_message[127] = '\0';
+    // Only a failing run stores a message, and only the first one is kept
+    if (error_msg && final_status != TEST_STATUS_PASSED && !test->error_message) {
+        test->error_message = framework_intern(error_msg);
     }
     
-    const char* status_str = "UNKNOWN";
-    switch (final_status) {
-        case TEST_STATUS_PASSED: status_str = "PASS"; break;
-        case TEST_STATUS_FAILED: status_str = "FAIL"; break;
-        case TEST_STATUS_SKIPPED: status_str = "SKIP"; break;
-        case TEST_STATUS_ERROR: status_str = "ERROR"; break;
-        default: break;
-    }
+    // Repeated tests get one line with the distribution instead
+    if (g_framework.repeat > 1) return;
     
-    printf("[%s] %s (%.3fs)\n", status_str, test->name, 
-           test->execution_time_ms / 1000.0f);
+    char duration[32];
+    printf("[%s] %s (%s)\n", test_status_name(final_status), test->name,
+           format_ns(test->execution_time_ns, duration, sizeof(duration)));
     
     if (final_status == TEST_STATUS_FAILED && error_msg) {
         printf("  Error: %s\n", error_msg);
@@ -199,15 +551,10 @@ void test_end(test_case_t* test, test_status_t final_status,
     }
 }
 
-// Comprehensive validation tests
-void run_gpio_validation_suite(void) {
-    test_suite_t* suite = framework_add_suite("GPIO Validation", 10);
-    
-    // Test 1: GPIO Direction Control
-    test_case_t* test1 = suite_add_test(suite, "GPIO_Direction_Control", 
-                                       "Verify GPIO direction register functionality", 
-                                       TEST_PRIORITY_HIGH);
-    test_start(test1);
+// Comprehensive validation tests. Each test sets up the state it relies on,
+// so the tests of a suite may run in any order.
+static void test_gpio_direction_control(test_case_t* test) {
+    test_start(test);
     
     hal_gpio_init();
     hal_gpio_set_direction(0, GPIO_OUTPUT);
@@ -216,66 +563,70 @@ void run_gpio_validation_suite(void) {
     // Simulate verification (in real hardware, read back direction register)
     bool direction_ok = true; // Assume success for simulation
     
-    test_end(test1, direction_ok ? TEST_STATUS_PASSED : TEST_STATUS_FAILED,
+    test_end(test, direction_ok ? TEST_STATUS_PASSED : TEST_STATUS_FAILED,
              direction_ok ? NULL : "Direction register mismatch", 1.0f, 1.0f, 0.0f);
+}
     
-    // Test 2: GPIO Data Write/Read
-    test_case_t* test2 = suite_add_test(suite, "GPIO_Data_WriteRead", 
-                                       "Verify GPIO data register write/read", 
-                                       TEST_PRIORITY_HIGH);
-    test_start(test2);
+static void test_gpio_data_write_read(test_case_t* test) {
+    test_start(test);
     
+    hal_gpio_set_direction(0, GPIO_OUTPUT);
     hal_gpio_write(0, 1);
     uint32_t gpio_state = hal_gpio_read(0);
     
-    test_end(test2, (gpio_state == 1) ? TEST_STATUS_PASSED : TEST_STATUS_FAILED,
+    test_end(test, (gpio_state == 1) ? TEST_STATUS_PASSED : TEST_STATUS_FAILED,
              (gpio_state == 1) ? NULL : "GPIO read/write mismatch", 
              gpio_state, 1.0f, 0.0f);
+}
     
-    // Test 3: GPIO Pattern Test
-    test_case_t* test3 = suite_add_test(suite, "GPIO_Pattern_Test", 
-                                       "Verify GPIO pattern generation", 
-                                       TEST_PRIORITY_MEDIUM);
-    test_start(test3);
+static void test_gpio_pattern(test_case_t* test) {
+    test_start(test);
+    
+    // Drive pins 0-2 as a 3-bit port: one masked update and one read per pattern
+    const uint32_t pattern_mask = 0x7;
+    hal_gpio_set_direction_mask(pattern_mask, GPIO_OUTPUT);
     
     bool pattern_ok = true;
-    for (int i = 0; i < 8; i++) {
-        hal_gpio_write(0, i & 1);
-        hal_gpio_write(1, (i >> 1) & 1);
-        hal_gpio_write(2, (i >> 2) & 1);
+    for (uint32_t i = 0; i < 8; i++) {
+        hal_gpio_modify(pattern_mask, i);
         
-        // Verify pattern (simplified for simulation)
-        uint32_t pin0 = hal_gpio_read(0);
-        if (pin0 != (i & 1)) {
+        uint32_t port = hal_gpio_read_port();
+        if ((port & pattern_mask) != i) {
             pattern_ok = false;
             break;
         }
     }
     
-    test_end(test3, pattern_ok ? TEST_STATUS_PASSED : TEST_STATUS_FAILED,
+    test_end(test, pattern_ok ? TEST_STATUS_PASSED : TEST_STATUS_FAILED,
              pattern_ok ? NULL : "GPIO pattern verification failed", 
              pattern_ok ? 1.0f : 0.0f, 1.0f, 0.0f);
 }
 
-void run_timer_validation_suite(void) {
-    test_suite_t* suite = framework_add_suite("Timer Validation", 5);
-    
-    // Test 1: Timer Initialization
-    test_case_t* test1 = suite_add_test(suite, "Timer_Initialization", 
-                                       "Verify timer initialization", 
-                                       TEST_PRIORITY_HIGH);
-    test_start(test1);
+void register_gpio_validation_suite(void) {
+    suite_id_t suite = framework_add_suite("GPIO Validation");
+    
+    suite_add_test(suite, "GPIO_Direction_Control",
+                   "Verify GPIO direction register functionality",
+                   TEST_PRIORITY_HIGH, test_gpio_direction_control, TEST_RESOURCE_GPIO);
+    suite_add_test(suite, "GPIO_Data_WriteRead",
+                   "Verify GPIO data register write/read",
+                   TEST_PRIORITY_HIGH, test_gpio_data_write_read, TEST_RESOURCE_GPIO);
+    suite_add_test(suite, "GPIO_Pattern_Test",
+                   "Verify GPIO pattern generation",
+                   TEST_PRIORITY_MEDIUM, test_gpio_pattern, TEST_RESOURCE_GPIO);
+}
+
+static void test_timer_initialization(test_case_t* test) {
+    test_start(test);
     
     hal_timer_init();
     uint32_t initial_count = hal_timer_get_count();
     
-    test_end(test1, TEST_STATUS_PASSED, NULL, initial_count, 0.0f, 1000.0f);
+    test_end(test, TEST_STATUS_PASSED, NULL, initial_count, 0.0f, 1000.0f);
+}
     
-    // Test 2: Timer Counting
-    test_case_t* test2 = suite_add_test(suite, "Timer_Counting", 
-                                       "Verify timer counting functionality", 
-                                       TEST_PRIORITY_HIGH);
-    test_start(test2);
+static void test_timer_counting(test_case_t* test) {
+    test_start(test);
     
     uint32_t start_count = hal_timer_get_count();
     hal_delay_ms(100);
@@ -285,13 +636,43 @@ void run_timer_validation_suite(void) {
     // Expect approximately 100ms worth of counts (tolerance depends on timer frequency)
     bool timing_ok = (elapsed > 50) && (elapsed < 200000); // Wide tolerance for simulation
     
-    test_end(test2, timing_ok ? TEST_STATUS_PASSED : TEST_STATUS_FAILED,
+    test_end(test, timing_ok ? TEST_STATUS_PASSED : TEST_STATUS_FAILED,
              timing_ok ? NULL : "Timer counting out of range", 
              elapsed, 100000.0f, 50000.0f);
 }
 
-void run_adc_validation_suite(void) {
-    test_suite_t* suite = framework_add_suite("ADC Validation", 8);
+void register_timer_validation_suite(void) {
+    suite_id_t suite = framework_add_suite("Timer Validation");
+    
+    suite_add_test(suite, "Timer_Initialization",
+                   "Verify timer initialization",
+                   TEST_PRIORITY_HIGH, test_timer_initialization, TEST_RESOURCE_TIMER);
+    suite_add_test(suite, "Timer_Counting",
+                   "Verify timer counting functionality",
+                   TEST_PRIORITY_HIGH, test_timer_counting, TEST_RESOURCE_TIMER);
+}
+
+// The ADC resource lock serializes the channel tests, so each one sets the
+// ADC up and reads its own channel
+static void test_adc_channel(test_case_t* test) {
+    test_start(test);
+    
+    hal_adc_init();
+    uint16_t adc_value = hal_adc_read_channel(test->parameter);
+    
+    // Convert to voltage (assuming 3.3V reference, 12-bit ADC)
+    float voltage = (adc_value * 3.3f) / 4095.0f;
+    
+    // Validate voltage is within reasonable range (0-3.3V)
+    bool voltage_valid = (voltage >= 0.0f) && (voltage <= 3.3f);
+    
+    test_end(test, voltage_valid ? TEST_STATUS_PASSED : TEST_STATUS_FAILED,
+             voltage_valid ? NULL : "ADC voltage out of range", 
+             voltage, 1.65f, 1.65f);
+}
+
+void register_adc_validation_suite(void) {
+    suite_id_t suite = framework_add_suite("ADC Validation");
     
     // Test ADC channels
     for (int channel = 0; channel < 4; channel++) {
@@ -300,32 +681,17 @@ void run_adc_validation_suite(void) {
         snprintf(test_name, sizeof(test_name), "ADC_Channel_%d", channel);
         snprintf(test_desc, sizeof(test_desc), "Verify ADC channel %d functionality", channel);
         
-        test_case_t* test = suite_add_test(suite, test_name, test_desc, TEST_PRIORITY_MEDIUM);
-        test_start(test);
-        
-        hal_adc_init();
-        uint16_t adc_value = hal_adc_read_channel(channel);
-        
-        // Convert to voltage (assuming 3.3V reference, 12-bit ADC)
-        float voltage = (adc_value * 3.3f) / 4095.0f;
-        
-        // Validate voltage is within reasonable range (0-3.3V)
-        bool voltage_valid = (voltage >= 0.0f) && (voltage <= 3.3f);
-        
-        test_end(test, voltage_valid ? TEST_STATUS_PASSED : TEST_STATUS_FAILED,
-                 voltage_valid ? NULL : "ADC voltage out of range", 
-                 voltage, 1.65f, 1.65f);
+        test_id_t id = suite_add_test(suite, test_name, test_desc, TEST_PRIORITY_MEDIUM,
+                                      test_adc_channel, TEST_RESOURCE_ADC);
+        test_case_t* test = framework_test(id);
+        if (test) {
+            test->parameter = (uint32_t)channel;
+        }
     }
 }
 
-void run_integration_validation_suite(void) {
-    test_suite_t* suite = framework_add_suite("Integration Tests", 3);
-    
-    // Test 1: System Integration
-    test_case_t* test1 = suite_add_test(suite, "System_Integration", 
-                                       "Verify complete system integration", 
-                                       TEST_PRIORITY_CRITICAL);
-    test_start(test1);
+static void test_system_integration(test_case_t* test) {
+    test_start(test);
     
     // Initialize all subsystems
     hal_system_init();
@@ -345,21 +711,19 @@ void run_integration_validation_suite(void) {
     // Verify all operations completed successfully
     bool integration_ok = (timer_end > timer_start) && (adc_reading < 4096);
     
-    test_end(test1, integration_ok ? TEST_STATUS_PASSED : TEST_STATUS_FAILED,
+    test_end(test, integration_ok ? TEST_STATUS_PASSED : TEST_STATUS_FAILED,
              integration_ok ? NULL : "System integration failure", 
              integration_ok ? 1.0f : 0.0f, 1.0f, 0.0f);
+}
     
-    // Test 2: Performance Benchmark
-    test_case_t* test2 = suite_add_test(suite, "Performance_Benchmark", 
-                                       "Measure system performance", 
-                                       TEST_PRIORITY_MEDIUM);
-    test_start(test2);
+static void test_performance_benchmark(test_case_t* test) {
+    test_start(test);
     
     uint32_t perf_start = hal_timer_get_count();
     
-    // Perform 1000 GPIO operations
+    // Perform 1000 GPIO operations (single toggle write each, no read-modify-write)
     for (int i = 0; i < 1000; i++) {
-        hal_gpio_write(0, i & 1);
+        hal_gpio_toggle_mask(1u << 0);
     }
     
     uint32_t perf_end = hal_timer_get_count();
@@ -368,133 +732,750 @@ void run_integration_validation_suite(void) {
     // Performance should be reasonable (less than 1 second for 1000 operations)
     bool perf_ok = perf_time < 1000000; // Adjust based on expected performance
     
-    test_end(test2, perf_ok ? TEST_STATUS_PASSED : TEST_STATUS_FAILED,
+    test_end(test, perf_ok ? TEST_STATUS_PASSED : TEST_STATUS_FAILED,
              perf_ok ? NULL : "Performance below expectations", 
              perf_time, 500000.0f, 500000.0f);
 }
 
-// Test execution and reporting
-void framework_run_all_tests(void) {
-    printf("\n=== Running All Validation Tests ===\n");
-    
-    // Run all test suites
-    run_gpio_validation_suite();
-    run_timer_validation_suite();
-    run_adc_validation_suite();
-    run_integration_validation_suite();
-    
-    // Calculate statistics
-    for (uint32_t i = 0; i < g_framework.suite_count; i++) {
-        test_suite_t* suite = &g_framework.suites[i];
-        
-        for (uint32_t j = 0; j < suite->test_count; j++) {
-            test_case_t* test = &suite->tests[j];
-            
-            switch (test->status) {
-                case TEST_STATUS_PASSED:
-                    suite->tests_passed++;
-                    g_framework.total_passed++;
-                    break;
-                case TEST_STATUS_FAILED:
-                case TEST_STATUS_ERROR:
-                    suite->tests_failed++;
-                    g_framework.total_failed++;
-                    break;
-                case TEST_STATUS_SKIPPED:
-                    suite->tests_skipped++;
-                    g_framework.total_skipped++;
-                    break;
-                default:
-                    break;
+void register_integration_validation_suite(void) {
+    suite_id_t suite = framework_add_suite("Integration Tests");
+    
+    // hal_system_init() re-initialises every peripheral
+    suite_add_test(suite, "System_Integration",
+                   "Verify complete system integration",
+                   TEST_PRIORITY_CRITICAL, test_system_integration, TEST_RESOURCE_ALL);
+    suite_add_test(suite, "Performance_Benchmark",
+                   "Measure system performance",
+                   TEST_PRIORITY_MEDIUM, test_performance_benchmark,
+                   TEST_RESOURCE_GPIO | TEST_RESOURCE_TIMER);
+}
+
+// Streaming reports. A test is appended to every open report as soon as its
+// runs are done, so nothing about the campaign is held back for the end.
+// Records collect in a large buffer; a flush writes them together with the
+// format's closing text (the footer) in one call, and the next flush starts
+// where that footer began and overwrites it. The file on disk is therefore
+// always a complete document, and a killed run leaves every flushed result.
+// Flushes happen when the buffer fills or REPORT_FLUSH_INTERVAL_NS has
+// passed; data is fsync'd at most every REPORT_SYNC_INTERVAL_NS and when
+// the report is finished.
+#define REPORT_BUFFER_SIZE        (64u * 1024u)
+#define REPORT_RECORD_MAX         8192      // Worst case for one test or footer
+#define REPORT_FIELD_MAX          256       // Longer strings are clipped
+#define REPORT_FLUSH_INTERVAL_NS  250000000ull
+#define REPORT_SYNC_INTERVAL_NS   1000000000ull
+
+typedef enum {
+    ESCAPE_XML,
+    ESCAPE_JSON
+} report_escape_t;
+
+typedef struct {
+    const char* name;
+    report_escape_t escape;
+    void (*header)(report_stream_t* stream);
+    void (*record)(report_stream_t* stream, const test_case_t* test);
+    void (*footer)(report_stream_t* stream, bool final);
+} report_format_t;
+
+struct report_stream {
+    const report_format_t* format;
+    const char* path;
+    FILE* file;
+    long footer_offset;         // Where the next flush starts writing
+    perf_ticks_t last_flush;
+    perf_ticks_t last_sync;
+    bool failed;
+    size_t used;
+    char buffer[REPORT_BUFFER_SIZE];
+};
+
+#if FRAMEWORK_HAVE_THREADS
+// Workers report their tests concurrently
+static pthread_mutex_t report_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+// Records stay below REPORT_RECORD_MAX, so clipping only guards the buffer
+static void report_putc(report_stream_t* stream, char c) {
+    if (stream->used < sizeof(stream->buffer) - 1) {
+        stream->buffer[stream->used++] = c;
+    }
+}
+
+static void report_printf(report_stream_t* stream, const char* format, ...) {
+    size_t space = sizeof(stream->buffer) - stream->used;
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(stream->buffer + stream->used, space, format, args);
+    va_end(args);
+    if (length > 0) {
+        stream->used += ((size_t)length < space) ? (size_t)length : space - 1;
+    }
+}
+
+// Escaped for the stream's format, without quotes, at most REPORT_FIELD_MAX
+// characters of text
+static void report_text(report_stream_t* stream, const char* text) {
+    for (size_t n = 0; text && text[n] && n < REPORT_FIELD_MAX; n++) {
+        unsigned char c = (unsigned char)text[n];
+        if (stream->format->escape == ESCAPE_XML) {
+            switch (c) {
+                case '&': report_printf(stream, "&amp;"); break;
+                case '<': report_printf(stream, "&lt;"); break;
+                case '>': report_printf(stream, "&gt;"); break;
+                case '"': report_printf(stream, "&quot;"); break;
+                case '\'': report_printf(stream, "&#39;"); break;
+                default: report_putc(stream, (c < 0x20 && c != '\t') ? '?' : (char)c); break;
             }
-            
-            suite->total_execution_time_ms += test->execution_time_ms;
+        } else if (c == '"' || c == '\\') {
+            report_putc(stream, '\\');
+            report_putc(stream, (char)c);
+        } else if (c < 0x20) {
+            report_printf(stream, "\\u%04x", c);
+        } else {
+            report_putc(stream, (char)c);
         }
     }
 }
 
-void framework_generate_report(void) {
-    FILE* report = fopen(g_framework.report_filename, "w");
-    if (!report) {
-        printf("Error: Could not create report file %s\n", g_framework.report_filename);
+// JSON has no NaN or infinity
+static void report_float(report_stream_t* stream, float value) {
+    if (value != value || value > 3.4e38f || value < -3.4e38f) {
+        report_printf(stream, "null");
+    } else {
+        report_printf(stream, "%.9g", value);
+    }
+}
+
+static void report_flush(report_stream_t* stream, bool final) {
+    size_t records = stream->used;
+    stream->format->footer(stream, final);
+    
+    // Records and footer in one write, over the previous footer, then cut
+    // off whatever a longer previous footer left past the new end
+    if (!stream->failed) {
+        bool ok = fseek(stream->file, stream->footer_offset, SEEK_SET) == 0 &&
+                  fwrite(stream->buffer, 1, stream->used, stream->file) == stream->used &&
+                  fflush(stream->file) == 0;
+#if FRAMEWORK_HAVE_TRUNCATE
+        ok = ok && ftruncate(fileno(stream->file),
+                             (off_t)stream->footer_offset + (off_t)stream->used) == 0;
+#endif
+        if (!ok) {
+            printf("Error: Could not write report file %s\n", stream->path);
+            stream->failed = true;
+        }
+    }
+    stream->footer_offset += (long)records;
+    stream->used = 0;
+    
+    perf_ticks_t now = perf_clock_now();
+    stream->last_flush = now;
+#if FRAMEWORK_HAVE_FSYNC
+    if (!stream->failed &&
+        (final || perf_clock_to_ns(now - stream->last_sync) >= REPORT_SYNC_INTERVAL_NS)) {
+        fsync(fileno(stream->file));
+        stream->last_sync = now;
+    }
+#endif
+}
+
+static const char* report_status_class(test_status_t status) {
+    switch (status) {
+        case TEST_STATUS_FAILED:
+        case TEST_STATUS_ERROR:
+            return "fail";
+        case TEST_STATUS_SKIPPED:
+            return "skip";
+        default:
+            return "pass";
+    }
+}
+
+static void report_html_header(report_stream_t* stream) {
+    report_printf(stream, "<!DOCTYPE html>\n<html>\n<head>\n");
+    report_printf(stream, "<title>FPGA Validation Report</title>\n");
+    report_printf(stream, "<style>\n");
+    report_printf(stream, "body { font-family: Arial, sans-serif; margin: 20px; }\n");
+    report_printf(stream, ".pass { color: green; }\n");
+    report_printf(stream, ".fail { color: red; }\n");
+    report_printf(stream, ".skip { color: orange; }\n");
+    report_printf(stream, "table { border-collapse: collapse; width: 100%%; }\n");
+    report_printf(stream, "th, td { border: 1px solid #ddd; padding: 8px; text-align: left; }\n");
+    report_printf(stream, "th { background-color: #f2f2f2; }\n");
+    report_printf(stream, "</style>\n</head>\n<body>\n");
+    
+    report_printf(stream, "<h1>FPGA Validation Framework Report</h1>\n");
+    report_printf(stream, "<p>Started: %s</p>\n", ctime(&g_framework.framework_start_time));
+    report_printf(stream, "<h2>Results</h2>\n");
+    report_printf(stream, "<table>\n");
+    report_printf(stream, "<tr><th>Suite</th><th>Test Name</th><th>Status</th><th>Runs</th>"
+                          "<th>Min</th><th>Median</th><th>P95</th><th>P99</th><th>Max</th>"
+                          "<th>Details</th></tr>\n");
+}
+
+static void report_html_record(report_stream_t* stream, const test_case_t* test) {
+    test_status_t status = TEST_RESULT(status, test->id);
+    test_timing_t timing = test_timing_get(test->id);
+    char min[32], median[32], p95[32], p99[32], max[32];
+    
+    report_printf(stream, "<tr><td>");
+    report_text(stream, framework_suite(TEST_RESULT(suite, test->id))->suite_name);
+    report_printf(stream, "</td><td>");
+    report_text(stream, test->name);
+    report_printf(stream, "</td><td class='%s'>%s</td><td>%u</td>"
+                          "<td>%s</td><td>%s</td><td>%s</td><td>%s</td><td>%s</td><td>",
+                  report_status_class(status), test_status_name(status), timing.runs,
+                  format_ns(timing.min_ns, min, sizeof(min)),
+                  format_ns(timing.median_ns, median, sizeof(median)),
+                  format_ns(timing.p95_ns, p95, sizeof(p95)),
+                  format_ns(timing.p99_ns, p99, sizeof(p99)),
+                  format_ns(timing.max_ns, max, sizeof(max)));
+    report_text(stream, test->error_message ? test->error_message : test->description);
+    report_printf(stream, "</td></tr>\n");
+}
+
+static void report_html_footer(report_stream_t* stream, bool final) {
+    report_printf(stream, "</table>\n");
+    if (!final) {
+        report_printf(stream, "<p>Incomplete: the run has not finished.</p>\n");
+        report_printf(stream, "</body>\n</html>\n");
         return;
     }
     
-    // Generate HTML report
-    fprintf(report, "<!DOCTYPE html>\n<html>\n<head>\n");
-    fprintf(report, "<title>FPGA Validation Report</title>\n");
-    fprintf(report, "<style>\n");
-    fprintf(report, "body { font-family: Arial, sans-serif; margin: 20px; }\n");
-    fprintf(report, ".pass { color: green; }\n");
-    fprintf(report, ".fail { color: red; }\n");
-    fprintf(report, ".skip { color: orange; }\n");
-    fprintf(report, "table { border-collapse: collapse; width: 100%%; }\n");
-    fprintf(report, "th, td { border: 1px solid #ddd; padding: 8px; text-align: left; }\n");
-    fprintf(report, "th { background-color: #f2f2f2; }\n");
-    fprintf(report, "</style>\n</head>\n<body>\n");
-    
-    fprintf(report, "<h1>FPGA Validation Framework Report</h1>\n");
-    fprintf(report, "<p>Generated: %s</p>\n", ctime((time_t*)&g_framework.framework_end_time));
-    
     // Summary statistics
-    fprintf(report, "<h2>Summary</h2>\n");
-    fprintf(report, "<table>\n");
-    fprintf(report, "<tr><th>Metric</th><th>Value</th></tr>\n");
-    fprintf(report, "<tr><td>Total Tests</td><td>%d</td></tr>\n", g_framework.total_tests);
-    fprintf(report, "<tr><td>Passed</td><td class='pass'>%d</td></tr>\n", g_framework.total_passed);
-    fprintf(report, "<tr><td>Failed</td><td class='fail'>%d</td></tr>\n", g_framework.total_failed);
-    fprintf(report, "<tr><td>Skipped</td><td class='skip'>%d</td></tr>\n", g_framework.total_skipped);
+    report_printf(stream, "<h2>Summary</h2>\n");
+    report_printf(stream, "<p>Generated: %s</p>\n", ctime(&g_framework.framework_end_time));
+    report_printf(stream, "<table>\n");
+    report_printf(stream, "<tr><th>Metric</th><th>Value</th></tr>\n");
+    report_printf(stream, "<tr><td>Total Tests</td><td>%u</td></tr>\n", g_framework.total_tests);
+    report_printf(stream, "<tr><td>Passed</td><td class='pass'>%u</td></tr>\n",
+                  g_framework.total_passed);
+    report_printf(stream, "<tr><td>Failed</td><td class='fail'>%u</td></tr>\n",
+                  g_framework.total_failed);
+    report_printf(stream, "<tr><td>Skipped</td><td class='skip'>%u</td></tr>\n",
+                  g_framework.total_skipped);
     
     float pass_rate = g_framework.total_tests > 0 ? 
                      (float)g_framework.total_passed / g_framework.total_tests * 100.0f : 0.0f;
-    fprintf(report, "<tr><td>Pass Rate</td><td>%.1f%%</td></tr>\n", pass_rate);
-    fprintf(report, "</table>\n");
+    report_printf(stream, "<tr><td>Pass Rate</td><td>%.1f%%</td></tr>\n", pass_rate);
+    report_printf(stream, "<tr><td>Runs per Test</td><td>%u</td></tr>\n", g_framework.repeat);
+    
+    char duration[32];
+    report_printf(stream, "<tr><td>Execution Time</td><td>%s</td></tr>\n",
+                  format_ns(ticks_to_ns(g_framework.run_start_ticks, g_framework.run_end_ticks),
+                            duration, sizeof(duration)));
+    report_printf(stream, "</table>\n");
+    report_printf(stream, "</body>\n</html>\n");
+}
+
+// One <testsuite>; the framework suite of each test is its classname
+static void report_junit_header(report_stream_t* stream) {
+    char timestamp[32];
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%S",
+             localtime(&g_framework.framework_start_time));
+    report_printf(stream, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    report_printf(stream, "<testsuites name=\"FPGA Validation\">\n");
+    report_printf(stream, "<testsuite name=\"FPGA Validation\" timestamp=\"%s\">\n", timestamp);
+}
+
+static void report_junit_record(report_stream_t* stream, const test_case_t* test) {
+    test_status_t status = TEST_RESULT(status, test->id);
+    
+    report_printf(stream, "  <testcase classname=\"");
+    report_text(stream, framework_suite(TEST_RESULT(suite, test->id))->suite_name);
+    report_printf(stream, "\" name=\"");
+    report_text(stream, test->name);
+    report_printf(stream, "\" time=\"%.9f\"", TEST_RESULT(total_ns, test->id) / 1e9);
+    
+    const char* element = NULL;
+    if (status == TEST_STATUS_FAILED) {
+        element = "failure";
+    } else if (status == TEST_STATUS_ERROR) {
+        element = "error";
+    } else if (status == TEST_STATUS_SKIPPED) {
+        element = "skipped";
+    }
+    if (!element) {
+        report_printf(stream, "/>\n");
+        return;
+    }
+    
+    report_printf(stream, ">\n    <%s message=\"", element);
+    report_text(stream, test->error_message ? test->error_message : "");
+    report_printf(stream, "\"/>\n  </testcase>\n");
+}
+
+static void report_junit_footer(report_stream_t* stream, bool final) {
+    (void)final;
+    report_printf(stream, "</testsuite>\n</testsuites>\n");
+}
+
+// One JSON object per line: every test, then a summary when the run finishes
+static void report_jsonl_header(report_stream_t* stream) {
+    (void)stream;
+}
+
+static void report_jsonl_record(report_stream_t* stream, const test_case_t* test) {
+    test_id_t id = test->id;
+    test_timing_t timing = test_timing_get(id);
+    
+    report_printf(stream, "{\"type\": \"test\", \"suite\": \"");
+    report_text(stream, framework_suite(TEST_RESULT(suite, id))->suite_name);
+    report_printf(stream, "\", \"name\": \"");
+    report_text(stream, test->name);
+    report_printf(stream, "\", \"status\": \"%s\", \"runs\": %u, \"total_ns\": %llu, "
+                          "\"min_ns\": %llu, \"median_ns\": %llu, \"p95_ns\": %llu, "
+                          "\"p99_ns\": %llu, \"max_ns\": %llu, \"measured\": ",
+                  test_status_name(TEST_RESULT(status, id)), timing.runs,
+                  (unsigned long long)timing.total_ns, (unsigned long long)timing.min_ns,
+                  (unsigned long long)timing.median_ns, (unsigned long long)timing.p95_ns,
+                  (unsigned long long)timing.p99_ns, (unsigned long long)timing.max_ns);
+    report_float(stream, TEST_RESULT(measured, id));
+    report_printf(stream, ", \"expected\": ");
+    report_float(stream, TEST_RESULT(expected, id));
+    report_printf(stream, ", \"tolerance\": ");
+    report_float(stream, TEST_RESULT(tolerance, id));
+    if (test->error_message) {
+        report_printf(stream, ", \"message\": \"");
+        report_text(stream, test->error_message);
+        report_printf(stream, "\"}\n");
+    } else {
+        report_printf(stream, ", \"message\": null}\n");
+    }
+}
+
+static void report_jsonl_footer(report_stream_t* stream, bool final) {
+    if (!final) return;
+    report_printf(stream, "{\"type\": \"summary\", \"tests\": %u, \"passed\": %u, \"failed\": %u, "
+                          "\"skipped\": %u, \"runs_per_test\": %u, \"execution_ns\": %llu}\n",
+                  g_framework.total_tests, g_framework.total_passed, g_framework.total_failed,
+                  g_framework.total_skipped, g_framework.repeat,
+                  (unsigned long long)ticks_to_ns(g_framework.run_start_ticks,
+                                                  g_framework.run_end_ticks));
+}
+
+static const report_format_t report_formats[REPORT_FORMAT_COUNT] = {
+    [REPORT_HTML]  = {"HTML", ESCAPE_XML, report_html_header, report_html_record,
+                      report_html_footer},
+    [REPORT_JUNIT] = {"JUnit XML", ESCAPE_XML, report_junit_header, report_junit_record,
+                      report_junit_footer},
+    [REPORT_JSONL] = {"JSON Lines", ESCAPE_JSON, report_jsonl_header, report_jsonl_record,
+                      report_jsonl_footer},
+};
+
+// Opens every report that has a path and writes its header and footer
+static void reports_open(void) {
+    for (uint32_t f = 0; f < REPORT_FORMAT_COUNT; f++) {
+        const char* path = g_framework.report_paths[f];
+        if (!path[0]) continue;
+        
+        report_stream_t* stream = malloc(sizeof(report_stream_t));
+        FILE* file = stream ? fopen(path, "w") : NULL;
+        if (!file) {
+            printf("Error: Could not create report file %s\n", path);
+            free(stream);
+            continue;
+        }
+        
+        // Our buffer already batches the writes
+        setvbuf(file, NULL, _IONBF, 0);
+        stream->format = &report_formats[f];
+        stream->path = path;
+        stream->file = file;
+        stream->footer_offset = 0;
+        stream->last_sync = perf_clock_now();
+        stream->failed = false;
+        stream->used = 0;
+        
+        stream->format->header(stream);
+        report_flush(stream, false);
+        g_framework.reports[f] = stream;
+        printf("Streaming %s report: %s\n", stream->format->name, path);
+    }
+}
+
+// Called once per test, after its last run
+static void report_test(const test_case_t* test) {
+#if FRAMEWORK_HAVE_THREADS
+    pthread_mutex_lock(&report_lock);
+#endif
+    for (uint32_t f = 0; f < REPORT_FORMAT_COUNT; f++) {
+        report_stream_t* stream = g_framework.reports[f];
+        if (!stream) continue;
+        
+        stream->format->record(stream, test);
+        bool full = stream->used > sizeof(stream->buffer) - 2 * REPORT_RECORD_MAX;
+        if (full || perf_clock_to_ns(perf_clock_now() - stream->last_flush) >=
+                    REPORT_FLUSH_INTERVAL_NS) {
+            report_flush(stream, false);
+        }
+    }
+#if FRAMEWORK_HAVE_THREADS
+    pthread_mutex_unlock(&report_lock);
+#endif
+}
+
+// final writes the closing summary; otherwise the reports are left marked
+// as incomplete
+static void reports_close(bool final) {
+    for (uint32_t f = 0; f < REPORT_FORMAT_COUNT; f++) {
+        report_stream_t* stream = g_framework.reports[f];
+        if (!stream) continue;
+        
+        report_flush(stream, final);
+        if (fclose(stream->file) != 0 && !stream->failed) {
+            printf("Error: Could not write report file %s\n", stream->path);
+            stream->failed = true;
+        }
+        if (final && !stream->failed) {
+            printf("Report generated: %s\n", stream->path);
+        }
+        free(stream);
+        g_framework.reports[f] = NULL;
+    }
+}
+
+// Set by the first failure when stop_on_failure is enabled
+static int framework_stopping;
+
+static int compare_ns(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of sorted samples
+static uint64_t percentile_ns(const uint64_t* sorted, uint32_t count, uint32_t percent) {
+    uint32_t rank = (uint32_t)(((uint64_t)count * percent + 99) / 100);
+    return sorted[(rank > 0 ? rank : 1) - 1];
+}
+
+static void test_timing_compute(test_timing_t* timing, uint64_t* samples, uint32_t count) {
+    memset(timing, 0, sizeof(*timing));
+    if (count == 0) return;
+    
+    qsort(samples, count, sizeof(uint64_t), compare_ns);
+    timing->runs = count;
+    for (uint32_t i = 0; i < count; i++) {
+        timing->total_ns += samples[i];
+    }
+    timing->min_ns = samples[0];
+    timing->median_ns = samples[count / 2];
+    timing->p95_ns = percentile_ns(samples, count, 95);
+    timing->p99_ns = percentile_ns(samples, count, 99);
+    timing->max_ns = samples[count - 1];
+}
+
+// Runs a test --repeat times. The first failing run decides the status
+// (its error message is kept); the timing covers every run.
+static void framework_run_test(test_case_t* test) {
+    if (__atomic_load_n(&framework_stopping, __ATOMIC_ACQUIRE)) {
+        test_start(test);
+        test_end(test, TEST_STATUS_SKIPPED, "Skipped after an earlier failure", 0.0f, 0.0f, 0.0f);
+        if (g_framework.repeat > 1) {
+            printf("[SKIP] %s\n", test->name);
+        }
+        report_test(test);
+        return;
+    }
+    
+    uint64_t single;
+    uint32_t repeat = g_framework.repeat;
+    uint64_t* samples = (repeat > 1) ? malloc(repeat * sizeof(uint64_t)) : &single;
+    if (!samples) {
+        samples = &single;
+        repeat = 1;
+    }
     
-    // Detailed results by suite
-    for (uint32_t i = 0; i < g_framework.suite_count; i++) {
-        test_suite_t* suite = &g_framework.suites[i];
+    test_status_t failure = TEST_STATUS_PASSED;
+    for (uint32_t r = 0; r < repeat; r++) {
+        test->run(test);
+        samples[r] = test->execution_time_ns;
         
-        fprintf(report, "<h2>%s</h2>\n", suite->suite_name);
-        fprintf(report, "<table>\n");
-        fprintf(report, "<tr><th>Test Name</th><th>Status</th><th>Time (ms)</th><th>Details</th></tr>\n");
+        test_status_t status = TEST_RESULT(status, test->id);
+        bool failed = (status == TEST_STATUS_FAILED || status == TEST_STATUS_ERROR);
+        if (failed && failure == TEST_STATUS_PASSED) {
+            failure = status;
+        }
+    }
+    if (failure != TEST_STATUS_PASSED) {
+        TEST_RESULT(status, test->id) = failure;
+    }
+    test_timing_t timing;
+    test_timing_compute(&timing, samples, repeat);
+    test_timing_put(test->id, &timing);
+    if (samples != &single) {
+        free(samples);
+    }
+    
+    if (g_framework.repeat > 1) {
+        char median[32];
+        char p99[32];
+        printf("[%s] %s x%u (median %s, p99 %s)\n",
+               test_status_name(TEST_RESULT(status, test->id)), test->name, timing.runs,
+               format_ns(timing.median_ns, median, sizeof(median)),
+               format_ns(timing.p99_ns, p99, sizeof(p99)));
+        if (failure != TEST_STATUS_PASSED && test->error_message) {
+            printf("  Error: %s\n", test->error_message);
+        }
+    }
+    
+    if (g_framework.stop_on_failure && failure != TEST_STATUS_PASSED) {
+        __atomic_store_n(&framework_stopping, 1, __ATOMIC_RELEASE);
+    }
+    report_test(test);
+}
+
+#if FRAMEWORK_HAVE_THREADS
+#define EXECUTOR_MAX_WORKERS 16
+
+// Per-worker test queue. The owner takes from the front and idle workers
+// steal from the back; either way only a test whose peripherals are all
+// free is taken.
+typedef struct {
+    test_case_t** tests;
+    uint32_t count;
+    pthread_mutex_t lock;
+} test_queue_t;
+
+typedef struct {
+    test_queue_t queues[EXECUTOR_MAX_WORKERS];
+    uint32_t worker_count;
+    pthread_mutex_t resource_locks[TEST_RESOURCE_COUNT];
+    pthread_mutex_t lock;       // Guards remaining and finished
+    pthread_cond_t changed;     // A test finished and freed its resources
+    uint32_t remaining;         // Queued or running
+    uint32_t finished;
+} test_executor_t;
+
+typedef struct {
+    test_executor_t* executor;
+    uint32_t id;
+} test_worker_t;
+
+static void executor_unlock(test_executor_t* executor, uint32_t resources) {
+    for (uint32_t r = 0; r < TEST_RESOURCE_COUNT; r++) {
+        if (resources & (1u << r)) {
+            pthread_mutex_unlock(&executor->resource_locks[r]);
+        }
+    }
+}
+
+// All or nothing, in ascending order, so two workers can't deadlock
+static bool executor_try_lock(test_executor_t* executor, uint32_t resources) {
+    for (uint32_t r = 0; r < TEST_RESOURCE_COUNT; r++) {
+        if (!(resources & (1u << r))) continue;
+        if (pthread_mutex_trylock(&executor->resource_locks[r]) != 0) {
+            executor_unlock(executor, resources & ((1u << r) - 1));
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns a test with its resources locked, or NULL when every queued test
+// needs a peripheral that a running test holds
+static test_case_t* executor_take(test_executor_t* executor, uint32_t id) {
+    for (uint32_t k = 0; k < executor->worker_count; k++) {
+        test_queue_t* queue = &executor->queues[(id + k) % executor->worker_count];
+        bool own = (k == 0);
         
-        for (uint32_t j = 0; j < suite->test_count; j++) {
-            test_case_t* test = &suite->tests[j];
+        pthread_mutex_lock(&queue->lock);
+        for (uint32_t n = 0; n < queue->count; n++) {
+            uint32_t slot = own ? n : queue->count - 1 - n;
+            test_case_t* test = queue->tests[slot];
+            if (!executor_try_lock(executor, test->resources)) continue;
             
-            const char* status_class = "pass";
-            const char* status_text = "PASS";
+            memmove(&queue->tests[slot], &queue->tests[slot + 1],
+                    (queue->count - slot - 1) * sizeof(test_case_t*));
+            queue->count--;
+            pthread_mutex_unlock(&queue->lock);
+            return test;
+        }
+        pthread_mutex_unlock(&queue->lock);
+    }
+    return NULL;
+}
+
+static void* executor_worker(void* arg) {
+    test_worker_t* worker = (test_worker_t*)arg;
+    test_executor_t* executor = worker->executor;
+    
+    for (;;) {
+        pthread_mutex_lock(&executor->lock);
+        uint32_t finished = executor->finished;
+        bool done = (executor->remaining == 0);
+        pthread_mutex_unlock(&executor->lock);
+        if (done) break;
+        
+        test_case_t* test = executor_take(executor, worker->id);
+        if (!test) {
+            // Nothing runnable until some test completes
+            pthread_mutex_lock(&executor->lock);
+            while (executor->remaining > 0 && executor->finished == finished) {
+                pthread_cond_wait(&executor->changed, &executor->lock);
+            }
+            pthread_mutex_unlock(&executor->lock);
+            continue;
+        }
+        
+        framework_run_test(test);
+        executor_unlock(executor, test->resources);
+        
+        pthread_mutex_lock(&executor->lock);
+        executor->remaining--;
+        executor->finished++;
+        pthread_cond_broadcast(&executor->changed);
+        pthread_mutex_unlock(&executor->lock);
+    }
+    return NULL;
+}
+
+// Returns false if the pool could not be set up
+static bool executor_run(uint32_t worker_count, uint32_t test_count) {
+    static test_executor_t executor;
+    uint32_t capacity = (test_count + worker_count - 1) / worker_count;
+    test_case_t** slots = malloc((size_t)worker_count * capacity * sizeof(test_case_t*));
+    if (!slots) return false;
+    
+    memset(&executor, 0, sizeof(executor));
+    executor.worker_count = worker_count;
+    executor.remaining = test_count;
+    pthread_mutex_init(&executor.lock, NULL);
+    pthread_cond_init(&executor.changed, NULL);
+    for (uint32_t r = 0; r < TEST_RESOURCE_COUNT; r++) {
+        pthread_mutex_init(&executor.resource_locks[r], NULL);
+    }
+    for (uint32_t w = 0; w < worker_count; w++) {
+        executor.queues[w].tests = slots + (size_t)w * capacity;
+        pthread_mutex_init(&executor.queues[w].lock, NULL);
+    }
+    
+    // Deal the tests round-robin; stealing evens out the rest
+    for (test_id_t id = 0; id < test_count; id++) {
+        test_queue_t* queue = &executor.queues[id % worker_count];
+        queue->tests[queue->count++] = framework_test(id);
+    }
+    
+    printf("Running %u tests on %u workers\n", test_count, worker_count);
+    
+    // The calling thread is worker 0; a worker that fails to start just
+    // leaves its queue to be stolen
+    pthread_t threads[EXECUTOR_MAX_WORKERS];
+    test_worker_t workers[EXECUTOR_MAX_WORKERS];
+    bool started[EXECUTOR_MAX_WORKERS] = {false};
+    for (uint32_t w = 0; w < worker_count; w++) {
+        workers[w].executor = &executor;
+        workers[w].id = w;
+        if (w > 0) {
+            started[w] = (pthread_create(&threads[w], NULL, executor_worker, &workers[w]) == 0);
+        }
+    }
+    executor_worker(&workers[0]);
+    
+    for (uint32_t w = 1; w < worker_count; w++) {
+        if (started[w]) {
+            pthread_join(threads[w], NULL);
+        }
+    }
+    
+    for (uint32_t w = 0; w < worker_count; w++) {
+        pthread_mutex_destroy(&executor.queues[w].lock);
+    }
+    for (uint32_t r = 0; r < TEST_RESOURCE_COUNT; r++) {
+        pthread_mutex_destroy(&executor.resource_locks[r]);
+    }
+    pthread_cond_destroy(&executor.changed);
+    pthread_mutex_destroy(&executor.lock);
+    free(slots);
+    return true;
+}
+#endif
+
+// Runs every registered test. Each test writes only its own test_case_t and
+// result slots, so results need no locking (error messages go through the
+// interning lock); the caller aggregates them after the join.
+static void framework_execute(void) {
+    uint32_t test_count = g_framework.tests.count;
+    
+    // The backend is picked on first use; pick it before workers race for it
+    hal_backend_auto_select();
+    __atomic_store_n(&framework_stopping, 0, __ATOMIC_RELEASE);
+
+#if FRAMEWORK_HAVE_THREADS
+    uint32_t workers = g_framework.jobs;
+    if (workers == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = (online > 0) ? (uint32_t)online : 1;
+    }
+    if (workers > EXECUTOR_MAX_WORKERS) workers = EXECUTOR_MAX_WORKERS;
+    if (workers > test_count) workers = test_count;
+    
+    if (workers > 1 && executor_run(workers, test_count)) return;
+#endif
+    
+    for (test_id_t id = 0; id < test_count; id++) {
+        framework_run_test(framework_test(id));
+    }
+}
+
+// Test execution and reporting
+void framework_run_all_tests(void) {
+    printf("\n=== Running All Validation Tests ===\n");
+    
+    // Register all test suites, then run their tests on the worker pool
+    register_gpio_validation_suite();
+    register_timer_validation_suite();
+    register_adc_validation_suite();
+    register_integration_validation_suite();
+    reports_open();
+    g_framework.run_start_ticks = perf_clock_now();
+    framework_execute();
+    g_framework.run_end_ticks = perf_clock_now();
+    g_framework.framework_end_time = time(NULL);
+    
+    // Calculate statistics once every worker has joined. Only the status,
+    // suite and total_ns columns are read, a chunk of tests at a time.
+    for (uint32_t chunk = 0; chunk * POOL_CHUNK_OBJECTS < g_framework.tests.count; chunk++) {
+        const test_results_t* results = g_framework.results[chunk];
+        uint32_t count = g_framework.tests.count - chunk * POOL_CHUNK_OBJECTS;
+        if (count > POOL_CHUNK_OBJECTS) count = POOL_CHUNK_OBJECTS;
+        
+        for (uint32_t slot = 0; slot < count; slot++) {
+            test_suite_t* suite = framework_suite(results->suite[slot]);
             
-            switch (test->status) {
+            switch (results->status[slot]) {
+                case TEST_STATUS_PASSED:
+                    suite->tests_passed++;
+                    g_framework.total_passed++;
+                    break;
                 case TEST_STATUS_FAILED:
                 case TEST_STATUS_ERROR:
-                    status_class = "fail";
-                    status_text = "FAIL";
+                    suite->tests_failed++;
+                    g_framework.total_failed++;
                     break;
                 case TEST_STATUS_SKIPPED:
-                    status_class = "skip";
-                    status_text = "SKIP";
+                    suite->tests_skipped++;
+                    g_framework.total_skipped++;
                     break;
                 default:
                     break;
             }
             
-            fprintf(report, "<tr><td>%s</td><td class='%s'>%s</td><td>%d</td><td>%s</td></tr>\n",
-                   test->name, status_class, status_text, test->execution_time_ms,
-                   test->error_message[0] ? test->error_message : test->description);
+            suite->total_execution_time_ns += results->total_ns[slot];
         }
-        
-        fprintf(report, "</table>\n");
     }
-    
-    fprintf(report, "</body>\n</html>\n");
-    fclose(report);
-    
-    printf("Report generated: %s\n", g_framework.report_filename);
+}
+
+// Closes the streamed reports with the run summary
+void framework_generate_report(void) {
+    reports_close(true);
 }
 
 void framework_print_summary(void) {
     printf("\n=== Validation Framework Summary ===\n");
-    printf("Total Test Suites: %d\n", g_framework.suite_count);
+    printf("Total Test Suites: %u\n", g_framework.suites.count);
     printf("Total Tests: %d\n", g_framework.total_tests);
     printf("Passed: %d\n", g_framework.total_passed);
     printf("Failed: %d\n", g_framework.total_failed);
@@ -504,8 +1485,23 @@ void framework_print_summary(void) {
                      (float)g_framework.total_passed / g_framework.total_tests * 100.0f : 0.0f;
     printf("Pass Rate: %.1f%%\n", pass_rate);
     
-    uint32_t total_time = g_framework.framework_end_time - g_framework.framework_start_time;
-    printf("Total Execution Time: %d seconds\n", total_time);
+    char duration[32];
+    uint64_t total_ns = ticks_to_ns(g_framework.run_start_ticks, g_framework.run_end_ticks);
+    printf("Total Execution Time: %s\n", format_ns(total_ns, duration, sizeof(duration)));
+    
+    // Per-test execution time over all runs
+    printf("\n%-24s %5s %12s %12s %12s %12s %12s\n",
+           "Test", "Runs", "Min", "Median", "P95", "P99", "Max");
+    for (test_id_t id = 0; id < g_framework.tests.count; id++) {
+        test_timing_t timing = test_timing_get(id);
+        char min[32], median[32], p95[32], p99[32], max[32];
+        printf("%-24s %5u %12s %12s %12s %12s %12s\n", framework_test(id)->name, timing.runs,
+               format_ns(timing.min_ns, min, sizeof(min)),
+               format_ns(timing.median_ns, median, sizeof(median)),
+               format_ns(timing.p95_ns, p95, sizeof(p95)),
+               format_ns(timing.p99_ns, p99, sizeof(p99)),
+               format_ns(timing.max_ns, max, sizeof(max)));
+    }
     
     printf("=====================================\n");
 }
@@ -516,6 +1512,10 @@ int main(int argc, char* argv[]) {
     bool verbose = false;
     bool stop_on_fail = false;
     const char* report_file = "fpga_validation_report.html";
+    const char* junit_file = NULL;
+    const char* jsonl_file = NULL;
+    uint32_t jobs = 0;
+    uint32_t repeat = 1;
     
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--verbose") == 0) {
@@ -524,11 +1524,23 @@ int main(int argc, char* argv[]) {
             stop_on_fail = true;
         } else if (strncmp(argv[i], "--report=", 9) == 0) {
             report_file = argv[i] + 9;
+        } else if (strncmp(argv[i], "--junit=", 8) == 0) {
+            junit_file = argv[i] + 8;
+        } else if (strncmp(argv[i], "--jsonl=", 8) == 0) {
+            jsonl_file = argv[i] + 8;
+        } else if (strncmp(argv[i], "--repeat=", 9) == 0) {
+            repeat = (uint32_t)strtoul(argv[i] + 9, NULL, 10);
+        } else if (strncmp(argv[i], "--jobs=", 7) == 0) {
+            jobs = (uint32_t)strtoul(argv[i] + 7, NULL, 10);
+        } else if (strncmp(argv[i], "-j", 2) == 0 && argv[i][2] != '\0') {
+            jobs = (uint32_t)strtoul(argv[i] + 2, NULL, 10);
         }
     }
     
     // Initialize validation framework
-    framework_init(report_file, verbose, stop_on_fail);
+    framework_init(report_file, verbose, stop_on_fail, jobs, repeat);
+    framework_set_report(REPORT_JUNIT, junit_file);
+    framework_set_report(REPORT_JSONL, jsonl_file);
     
     // Run all validation tests
     framework_run_all_tests();
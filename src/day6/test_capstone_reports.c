@@ -0,0 +1,388 @@
+#define _POSIX_C_SOURCE 200112L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+// Streamed reports must parse, whether the run finished or was killed:
+//   - JUnit XML: well formed (nested tags, quoted attributes, only known
+//     entities), one <testsuites> root, one <testcase> per test
+//   - JSON Lines: every line one valid JSON object; a test line per test,
+//     and a summary line that counts them only when the run finished
+// The killed run is slowed down with the simulator's real-time mode: with
+// one worker the first flush comes after Timer_Counting (100 ms a run) at
+// about 3 s, and the process is SIGKILLed then, 1.5 s before it would end.
+//
+// usage: capstone_reports_test <validation_framework>
+
+#define REPORT_JUNIT "capstone_check_junit.xml"
+#define REPORT_JSONL "capstone_check_results.jsonl"
+
+static int failures = 0;
+
+static void check(const char* what, int ok) {
+    printf("  %-48s %s\n", what, ok ? "OK" : "FAIL");
+    if (!ok) failures++;
+}
+
+static char* read_file(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    
+    char* text = length >= 0 ? malloc((size_t)length + 1) : NULL;
+    if (text && fread(text, 1, (size_t)length, file) != (size_t)length) {
+        free(text);
+        text = NULL;
+    }
+    if (text) {
+        text[length] = '\0';
+    }
+    fclose(file);
+    return text;
+}
+
+// XML ------------------------------------------------------------------
+
+#define XML_MAX_DEPTH 16
+
+static const char* xml_entity(const char* p) {
+    static const char* const named[] = { "&amp;", "&lt;", "&gt;", "&quot;", "&apos;" };
+    for (size_t i = 0; i < sizeof(named) / sizeof(named[0]); i++) {
+        if (strncmp(p, named[i], strlen(named[i])) == 0) {
+            return p + strlen(named[i]);
+        }
+    }
+    if (p[1] != '#') return NULL;
+    const char* q = p + 2;
+    while (*q >= '0' && *q <= '9') q++;
+    return (q > p + 2 && *q == ';') ? q + 1 : NULL;
+}
+
+// Character data up to the next '<', or up to quote inside an attribute
+static const char* xml_text(const char* p, char quote) {
+    while (*p && *p != '<' && *p != quote) {
+        if (*p == '&') {
+            p = xml_entity(p);
+            if (!p) return NULL;
+        } else {
+            p++;
+        }
+    }
+    return p;
+}
+
+static const char* xml_name(const char* p, char* name, size_t room) {
+    size_t length = 0;
+    while (*p && !strchr(" \t\r\n/>=\"'", *p)) {
+        if (length + 1 < room) name[length++] = *p;
+        p++;
+    }
+    name[length] = '\0';
+    return length ? p : NULL;
+}
+
+static const char* xml_space(const char* p) {
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+    return p;
+}
+
+// Well formed with a single root element; counts elements named element
+static bool xml_parse(const char* p, const char* root, const char* element, int* count) {
+    char stack[XML_MAX_DEPTH][64];
+    int depth = 0;
+    int roots = 0;
+    *count = 0;
+    
+    if (strncmp(p, "<?xml ", 6) == 0) {
+        p = strstr(p, "?>");
+        if (!p) return false;
+        p += 2;
+    }
+    for (;;) {
+        p = depth ? xml_text(p, '\0') : xml_space(p);
+        if (!p) return false;
+        if (!*p) break;
+        if (*p != '<') return false;  // Text outside the root
+        p++;
+        
+        if (*p == '/') {
+            char name[64];
+            p = xml_name(p + 1, name, sizeof(name));
+            if (!p || depth == 0 || strcmp(name, stack[depth - 1]) != 0) return false;
+            p = xml_space(p);
+            if (*p++ != '>') return false;
+            depth--;
+            continue;
+        }
+        
+        if (depth == XML_MAX_DEPTH) return false;
+        p = xml_name(p, stack[depth], sizeof(stack[depth]));
+        if (!p) return false;
+        if (depth == 0 && (roots++ > 0 || strcmp(stack[0], root) != 0)) return false;
+        if (strcmp(stack[depth], element) == 0) (*count)++;
+        
+        // Attributes: name="value" or name='value'
+        for (;;) {
+            p = xml_space(p);
+            if (*p == '/' || *p == '>') break;
+            char attribute[64];
+            p = xml_name(p, attribute, sizeof(attribute));
+            if (!p || *p != '=' || (p[1] != '"' && p[1] != '\'')) return false;
+            char quote = p[1];
+            p = xml_text(p + 2, quote);
+            if (!p || *p != quote) return false;
+            p++;
+        }
+        if (*p == '/') {
+            if (p[1] != '>') return false;
+            p += 2;
+        } else {
+            p++;
+            depth++;
+        }
+    }
+    return depth == 0 && roots == 1;
+}
+
+// JSON -----------------------------------------------------------------
+
+static const char* json_value(const char* p, int depth);
+
+static const char* json_space(const char* p) {
+    while (*p == ' ' || *p == '\t') p++;
+    return p;
+}
+
+static const char* json_string(const char* p) {
+    if (*p++ != '"') return NULL;
+    while (*p != '"') {
+        unsigned char c = (unsigned char)*p;
+        if (c < 0x20) return NULL;  // Includes the terminator
+        if (c == '\\') {
+            p++;
+            if (*p == 'u') {
+                for (int i = 1; i <= 4; i++) {
+                    if (!strchr("0123456789abcdefABCDEF", p[i]) || !p[i]) return NULL;
+                }
+                p += 4;
+            } else if (!*p || !strchr("\"\\/bfnrt", *p)) {
+                return NULL;
+            }
+        }
+        p++;
+    }
+    return p + 1;
+}
+
+static const char* json_digits(const char* p) {
+    const char* start = p;
+    while (*p >= '0' && *p <= '9') p++;
+    return p > start ? p : NULL;
+}
+
+static const char* json_number(const char* p) {
+    if (*p == '-') p++;
+    if (*p == '0') {
+        p++;
+    } else if (!(p = json_digits(p))) {
+        return NULL;
+    }
+    if (*p == '.' && !(p = json_digits(p + 1))) return NULL;
+    if (*p == 'e' || *p == 'E') {
+        p++;
+        if (*p == '+' || *p == '-') p++;
+        p = json_digits(p);
+    }
+    return p;
+}
+
+static const char* json_members(const char* p, char close, int depth) {
+    p = json_space(p + 1);
+    if (*p == close) return p + 1;
+    for (;;) {
+        if (close == '}') {
+            p = json_string(json_space(p));
+            if (!p) return NULL;
+            p = json_space(p);
+            if (*p++ != ':') return NULL;
+        }
+        p = json_value(p, depth + 1);
+        if (!p) return NULL;
+        p = json_space(p);
+        if (*p == close) return p + 1;
+        if (*p++ != ',') return NULL;
+    }
+}
+
+static const char* json_value(const char* p, int depth) {
+    if (depth > 16) return NULL;
+    p = json_space(p);
+    switch (*p) {
+        case '{': return json_members(p, '}', depth);
+        case '[': return json_members(p, ']', depth);
+        case '"': return json_string(p);
+        case 't': return strncmp(p, "true", 4) == 0 ? p + 4 : NULL;
+        case 'f': return strncmp(p, "false", 5) == 0 ? p + 5 : NULL;
+        case 'n': return strncmp(p, "null", 4) == 0 ? p + 4 : NULL;
+        default: return json_number(p);
+    }
+}
+
+typedef struct {
+    bool valid;                 // Every line one JSON object, newline-terminated
+    int tests;                  // "type": "test" lines
+    int summaries;              // "type": "summary" lines, last only
+    int summary_tests;          // Its "tests" count
+} jsonl_result_t;
+
+static jsonl_result_t jsonl_parse(const char* p) {
+    jsonl_result_t result = {true, 0, 0, -1};
+    while (*p) {
+        const char* line = p;
+        if (*p != '{') {
+            result.valid = false;
+            break;
+        }
+        p = json_value(p, 0);
+        if (!p || *json_space(p) != '\n') {
+            result.valid = false;
+            break;
+        }
+        p = json_space(p) + 1;
+        
+        if (result.summaries > 0) {
+            result.valid = false;  // Nothing may follow the summary
+        } else if (strncmp(line, "{\"type\": \"test\",", 16) == 0) {
+            result.tests++;
+        } else if (strncmp(line, "{\"type\": \"summary\",", 19) == 0) {
+            result.summaries++;
+            const char* tests = strstr(line, "\"tests\": ");
+            if (tests && tests < p) {
+                result.summary_tests = atoi(tests + 9);
+            }
+        } else {
+            result.valid = false;
+        }
+    }
+    return result;
+}
+
+// Runs ---------------------------------------------------------------------
+
+static void check_reports(bool finished) {
+    char* junit = read_file(REPORT_JUNIT);
+    char* jsonl = read_file(REPORT_JSONL);
+    check("both reports read back", junit && jsonl);
+    if (!junit || !jsonl) {
+        free(junit);
+        free(jsonl);
+        return;
+    }
+    
+    int testcases = 0;
+    check("JUnit XML well formed", xml_parse(junit, "testsuites", "testcase", &testcases));
+    jsonl_result_t lines = jsonl_parse(jsonl);
+    check("every JSON Lines line is a JSON object", lines.valid);
+    printf("  %d testcases, %d test lines, %d summary\n",
+           testcases, lines.tests, lines.summaries);
+    check("at least one result", lines.tests > 0);
+    check("same tests in both reports", testcases == lines.tests);
+    if (finished) {
+        check("summary counts every test",
+              lines.summaries == 1 && lines.summary_tests == lines.tests);
+    } else {
+        check("no summary yet", lines.summaries == 0);
+    }
+    free(junit);
+    free(jsonl);
+}
+
+// A complete line in the JSON Lines report; the file may not exist yet
+static bool flushed_results(void) {
+    FILE* file = fopen(REPORT_JSONL, "r");
+    if (!file) return false;
+    
+    int c;
+    while ((c = fgetc(file)) != EOF && c != '\n') {
+    }
+    fclose(file);
+    return c == '\n';
+}
+
+static void check_finished(const char* framework) {
+    printf("Finished run:\n");
+    char command[1024];
+    snprintf(command, sizeof(command),
+             "\"%s\" --jobs=4 --junit=" REPORT_JUNIT " --jsonl=" REPORT_JSONL " > /dev/null",
+             framework);
+    check("framework exits cleanly", system(command) == 0);
+    check_reports(true);
+}
+
+static void check_killed(const char* framework) {
+    printf("Killed run:\n");
+    remove(REPORT_JSONL);
+    fflush(stdout);  // Or the child repeats what is still buffered
+    pid_t pid = fork();
+    if (pid == 0) {
+        if (!freopen("/dev/null", "w", stdout)) {
+            _exit(127);
+        }
+        setenv("FPGA_HAL_SIM_REALTIME", "1", 1);
+        execl(framework, framework, "--jobs=1", "--repeat=30", "--junit=" REPORT_JUNIT,
+              "--jsonl=" REPORT_JSONL, (char*)NULL);
+        _exit(127);
+    }
+    check("framework started", pid > 0);
+    if (pid <= 0) {
+        return;
+    }
+    
+    // Up to 10 s for the first flushed result
+    struct timespec poll = {0, 20000000};
+    int status = 0;
+    bool running = true;
+    for (int i = 0; i < 500 && !flushed_results(); i++) {
+        if (waitpid(pid, &status, WNOHANG) == pid) {
+            running = false;
+            break;
+        }
+        nanosleep(&poll, NULL);
+    }
+    if (running) {
+        kill(pid, SIGKILL);
+        waitpid(pid, &status, 0);
+    }
+    check("killed before the run finished", WIFSIGNALED(status));
+    check_reports(false);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <validation_framework>\n", argv[0]);
+        return 2;
+    }
+    
+    check_finished(argv[1]);
+    check_killed(argv[1]);
+    remove(REPORT_JUNIT);
+    remove(REPORT_JSONL);
+    
+    if (failures) {
+        printf("%d report check(s) FAILED\n", failures);
+        return 1;
+    }
+    printf("All report checks passed\n");
+    return 0;
+}
@@ -14,6 +14,10 @@ GREEN='\033[0;32m'
 YELLOW='\033[1;33m'
 NC='\033[0m' # No Color
 
+# FPGA HAL core plus its register access backends (relative to src/day4)
+HAL_SOURCES="fpga_hal.c hal_adc_scan.c hal_adc_stream.c hal_uart_tx.c hal_timebase.c hal_freq.c hal_backend.c hal_sim.c hal_backend_record.c hal_backend_mapped.c"
+DAY6_HAL_SOURCES=$(for f in $HAL_SOURCES; do printf '../day4/%s ' "$f"; done)
+
 # Test counters
 TOTAL_TESTS=0
 PASSED_TESTS=0
@@ -106,12 +110,12 @@ cd src/day4 2>/dev/null || { echo "Day 4 directory not found"; exit 1; }
 
 # Test individual components
 compile_and_test "validation_lib.c" "Day4_Validation_Lib_Compile"
-compile_and_test "fpga_hal.c" "Day4_FPGA_HAL_Compile"
+compile_and_test "$HAL_SOURCES" "Day4_FPGA_HAL_Compile"
 
 # Test complete exercises
 compile_and_test "exercise1_validation_lib.c validation_lib.c" "Day4_Validation_Library"
-compile_and_test "exercise2_fpga_hal.c fpga_hal.c" "Day4_FPGA_HAL"
-compile_and_test "exercise3_cross_compile.c fpga_hal.c validation_lib.c" "Day4_Cross_Compile"
+compile_and_test "exercise2_fpga_hal.c $HAL_SOURCES" "Day4_FPGA_HAL"
+compile_and_test "exercise3_cross_compile.c $HAL_SOURCES validation_lib.c validation_batch.c validation_stats.c limits_table.c validation_fixed.c validation_sink.c binning.c power_analyzer.c perf_clock.c -lm -pthread" "Day4_Cross_Compile"
 
 # Test CMake build
 if [ -f "CMakeLists.txt" ]; then
@@ -138,7 +142,7 @@ cd src/day6 2>/dev/null || { echo "Day 6 directory not found"; exit 1; }
 
 # Need to include Day 4 libraries for capstone
 if [ -f "../day4/validation_lib.c" ] && [ -f "../day4/fpga_hal.c" ]; then
-    run_test "Day6_Capstone_Compile" "gcc -Wall -Wextra -std=c99 -g -I../day4 -o capstone capstone_validation_framework.c ../day4/validation_lib.c ../day4/fpga_hal.c"
+    run_test "Day6_Capstone_Compile" "gcc -Wall -Wextra -std=c99 -g -I../day4 -o capstone capstone_validation_framework.c ../day4/validation_lib.c ../day4/validation_batch.c ../day4/validation_stats.c ../day4/limits_table.c ../day4/validation_fixed.c ../day4/validation_sink.c ../day4/binning.c ../day4/power_analyzer.c ../day4/perf_clock.c $DAY6_HAL_SOURCES -lm -pthread"
     if [ -f "capstone" ]; then
         run_test "Day6_Capstone_Execute" "./capstone --verbose"
         rm -f capstone
@@ -162,7 +166,7 @@ if command -v riscv32-unknown-elf-gcc >/dev/null 2>&1; then
     echo "RISC-V toolchain found, testing cross-compilation..."
     
     cd src/day4
-    run_test "RISC-V_Cross_Compile" "riscv32-unknown-elf-gcc -march=rv32imac -mabi=ilp32 -o test_riscv exercise3_cross_compile.c fpga_hal.c validation_lib.c"
+    run_test "RISC-V_Cross_Compile" "riscv32-unknown-elf-gcc -march=rv32imac -mabi=ilp32 -o test_riscv exercise3_cross_compile.c $HAL_SOURCES validation_lib.c validation_batch.c validation_stats.c limits_table.c validation_fixed.c validation_sink.c binning.c power_analyzer.c perf_clock.c -lm"
     rm -f test_riscv
     cd ../..
 else